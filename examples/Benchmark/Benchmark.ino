@@ -0,0 +1,309 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+
+const unsigned long Samples = 1000;
+
+// Fits an Arduino Uno (2 KB of RAM). Nodes hold pointers, so the arena grows with them on 32 and 64 bits boards
+SyncStaticArena<sizeof(void*) * 192> arena;
+
+// Mock clock, so GetValue() is evaluated at known instants
+unsigned long mockMillis = 0;
+unsigned long MockClock() { return mockMillis; }
+
+volatile float sink;
+volatile int32_t sinkQ16;
+
+// Arena use at the previous report, the difference is what the reported function allocated
+unsigned int reportedAllocations = 0;
+size_t reportedBytes = 0;
+
+void ResetArena()
+{
+	arena.Reset();
+	reportedAllocations = 0;
+	reportedBytes = 0;
+}
+
+// Nodes (and bytes) placed in the arena to build the reported function, e.g. 1 for each transformation
+void PrintAllocations()
+{
+	Serial.print('\t');
+	Serial.print(arena.Allocations - reportedAllocations);
+	Serial.print(F(" nodes\t"));
+	Serial.print(arena.GetUsed() - reportedBytes);
+	Serial.print(F(" bytes"));
+	reportedAllocations = arena.Allocations;
+	reportedBytes = arena.GetUsed();
+}
+
+void Report(const __FlashStringHelper* name, SyncFunction& function)
+{
+	// Sweeps 0 - Interval, wrapping with a comparison so the loop only measures the function
+	const unsigned long interval = function.Interval;
+	unsigned long elapsed = 0;
+
+	const unsigned long start = micros();
+	for (unsigned long sample = 0; sample < Samples; sample++)
+	{
+		sink = function.GetValue(elapsed);
+		elapsed = elapsed < interval ? elapsed + 1 : 0;
+	}
+	const unsigned long cost = micros() - start;
+
+	Serial.print(name);
+	Serial.print('\t');
+	Serial.print(cost * 1000UL / Samples);
+	Serial.print(F(" ns/sample"));
+	PrintAllocations();
+	Serial.println();
+}
+
+// Scattered instants, so periodic nodes can not track the time incrementally
+void ReportJumps(const __FlashStringHelper* name, SyncFunction& function)
+{
+	unsigned long elapsed = 0;
+
+	const unsigned long start = micros();
+	for (unsigned long sample = 0; sample < Samples; sample++)
+	{
+		sink = function.GetValue(elapsed);
+		elapsed += 7919UL;
+		if (elapsed >= 10007UL) elapsed -= 10007UL;
+	}
+	const unsigned long cost = micros() - start;
+
+	Serial.print(name);
+	Serial.print('\t');
+	Serial.print(cost * 1000UL / Samples);
+	Serial.print(F(" ns/sample"));
+	PrintAllocations();
+	Serial.println();
+}
+
+// Same sweep as Report(), with GetValueQ16()
+void ReportQ16(const __FlashStringHelper* name, SyncFunction& function)
+{
+	const unsigned long interval = function.Interval;
+	unsigned long elapsed = 0;
+
+	const unsigned long start = micros();
+	for (unsigned long sample = 0; sample < Samples; sample++)
+	{
+		sinkQ16 = function.GetValueQ16(elapsed);
+		elapsed = elapsed < interval ? elapsed + 1 : 0;
+	}
+	const unsigned long cost = micros() - start;
+
+	Serial.print(name);
+	Serial.print(F(" (Q16)\t"));
+	Serial.print(cost * 1000UL / Samples);
+	Serial.println(F(" ns/sample"));
+}
+
+void ReportAllocations(const __FlashStringHelper* name)
+{
+	Serial.print(name);
+	Serial.print('\t');
+	Serial.print(arena.Allocations);
+	Serial.print(F(" nodes, "));
+	Serial.print(arena.GetUsed());
+	Serial.println(F(" bytes"));
+}
+
+// RAM of one node of each class, see SYNC_COMPACT_NODES and SYNC_SHORT_INTERVALS
+void ReportSize(const __FlashStringHelper* name, size_t size)
+{
+	Serial.print(name);
+	Serial.print('\t');
+	Serial.print(size);
+	Serial.println(F(" bytes"));
+}
+
+void setup()
+{
+	while (!Serial) { ; }
+
+	Serial.begin(115200);
+
+	SyncArena::Use(arena);
+
+	Serial.println(F("-- Memory"));
+	ReportSize(F("Zeros"), sizeof(SyncZeros));
+	ReportSize(F("Constant"), sizeof(SyncConstant));
+	ReportSize(F("Delta"), sizeof(SyncDelta));
+	ReportSize(F("Step"), sizeof(SyncStep));
+	ReportSize(F("Ramp"), sizeof(SyncRamp));
+	ReportSize(F("InverseRamp"), sizeof(SyncInverseRamp));
+	ReportSize(F("Triangular"), sizeof(SyncTriangular));
+	ReportSize(F("Trapezium"), sizeof(SyncTrapezium));
+	ReportSize(F("Sin"), sizeof(SyncSin));
+	ReportSize(F("Cos"), sizeof(SyncCos));
+	ReportSize(F("Easing"), sizeof(SyncEasing));
+	ReportSize(F("Speed"), sizeof(SyncTransformationSpeed));
+	ReportSize(F("ScaleY"), sizeof(SyncTransformationScaleY));
+	ReportSize(F("OffsetY"), sizeof(SyncTransformationOffsetY));
+	ReportSize(F("AffineY"), sizeof(SyncTransformationAffineY));
+	ReportSize(F("SliceX"), sizeof(SyncTransformationSliceX));
+	ReportSize(F("Delay"), sizeof(SyncTransformationDelay));
+	ReportSize(F("Inverse"), sizeof(SyncTransformationInverse));
+	ReportSize(F("Reverse"), sizeof(SyncTransformationReverse));
+	ReportSize(F("RepeatN"), sizeof(SyncRepeatN));
+	ReportSize(F("RepeatInfinite"), sizeof(SyncRepeatInfinite));
+	ReportSize(F("Mirroring"), sizeof(SyncMirroring));
+	ReportSize(F("Curve"), sizeof(SyncTransformationCurve));
+	ReportSize(F("Memo"), sizeof(SyncMemo));
+	ReportSize(F("Root"), sizeof(SyncRoot));
+	ReportSize(F("Add"), sizeof(SyncAdd));
+	ReportSize(F("Substract"), sizeof(SyncSubstract));
+	ReportSize(F("Max"), sizeof(SyncMax));
+	ReportSize(F("Min"), sizeof(SyncMin));
+	ReportSize(F("And"), sizeof(SyncAnd));
+	ReportSize(F("Or"), sizeof(SyncOr));
+	ReportSize(F("Concatenate"), sizeof(SyncConcatenate));
+	ReportSize(F("AddN<4>"), sizeof(SyncAddN<4>));
+	ReportSize(F("Sequence<4>"), sizeof(SyncSequence<4>));
+	ReportSize(F("PWM (inline)"), sizeof(SyncPWM(500, 1000)));
+
+	Serial.println(F("-- Functions"));
+	auto zeros = SyncZeros(250);
+	auto constant = SyncConstant(250, 1.0);
+	auto delta = SyncDelta(250);
+	auto step = SyncStep(250);
+	auto ramp = SyncRamp(250);
+	auto iramp = SyncInverseRamp(250);
+	auto triangular = SyncTriangular(100, 150);
+	auto trapezium = SyncTrapezium(50, 150, 100);
+	auto sine = SyncSin(250);
+	auto fastSine = SyncSin(250, true);
+	auto cosine = SyncCos(250);
+	auto easing = SyncEasing(250, SyncCurve(SyncCurveType::CubicInOut));
+	Report(F("Zeros"), zeros);
+	Report(F("Constant"), constant);
+	Report(F("Delta"), delta);
+	Report(F("Step"), step);
+	Report(F("Ramp"), ramp);
+	Report(F("InverseRamp"), iramp);
+	Report(F("Triangular"), triangular);
+	Report(F("Trapezium"), trapezium);
+	Report(F("Sin"), sine);
+	Report(F("Sin (fast)"), fastSine);
+	Report(F("Cos"), cosine);
+	Report(F("Easing (cubic)"), easing);
+
+	Serial.println(F("-- Transformations"));
+	Report(F("Speed"), ramp.Speed(2.0));
+	Report(F("ScaleY"), ramp.ScaleY(2.0));
+	Report(F("OffsetY"), ramp.OffsetY(0.5));
+	Report(F("SliceX"), ramp.SliceX(50));
+	Report(F("Delay"), ramp.Delay(50));
+	Report(F("Inverse"), ramp.Inverse());
+	Report(F("Reverse"), ramp.Reverse());
+	Report(F("RepeatN"), ramp.Repeat(4));
+	Report(F("RepeatInfinite"), ramp.Repeat());
+	Report(F("Mirroring"), ramp.Mirroring());
+	Report(F("Curve (gamma)"), ramp.Curve(SyncCurve(SyncCurveType::Gamma, 2.2)));
+	Report(F("Curve (Bezier)"), ramp.Curve(SyncCurve(SyncCurveType::Bezier, 0.1, 0.9)));
+	ReportAllocations(F("Transformations"));
+
+	// Repetitions are tracked without division while time goes forward, and with a mask for power of two intervals
+	Serial.println(F("-- Periods"));
+	ResetArena();
+	auto ramp256 = SyncRamp(256);
+	Report(F("RepeatInfinite"), ramp.Repeat());
+	ReportJumps(F("RepeatInfinite (jumps)"), ramp.Repeat());
+	Report(F("RepeatInfinite (256)"), ramp256.Repeat());
+	Report(F("SliceX (negative)"), ramp.SliceX(-50));
+
+	Serial.println(F("-- Operations"));
+	ResetArena();
+	auto add = SyncAdd(ramp, sine);
+	auto substract = SyncSubstract(ramp, sine);
+	auto maximum = SyncMax(ramp, sine);
+	auto minimum = SyncMin(ramp, sine);
+	auto andOp = SyncAnd(step, sine);
+	auto orOp = SyncOr(step, sine);
+	auto concatenate = ramp + sine;
+	Report(F("Add"), add);
+	Report(F("Substract"), substract);
+	Report(F("Max"), maximum);
+	Report(F("Min"), minimum);
+	Report(F("And"), andOp);
+	Report(F("Or"), orOp);
+	Report(F("Concatenate"), concatenate);
+
+	// Eight layers, as a chain of binary operations and as a single N-ary one
+	SyncFunction* chain = &ramp;
+	for (uint8_t layer = 1; layer < 8; layer++) chain = &SyncNew<SyncAdd>(*chain, layer % 2 ? static_cast<SyncFunction&>(sine) : triangular);
+	Report(F("Add x8 (chain)"), *chain);
+	Report(F("Add x8 (N-ary)"), SyncAddAll(ramp, sine, triangular, sine, triangular, sine, triangular, sine));
+	SyncFunction* sequence8 = &ramp;
+	for (uint8_t part = 1; part < 8; part++) sequence8 = &SyncNew<SyncConcatenate>(*sequence8, part % 2 ? static_cast<SyncFunction&>(sine) : triangular);
+	Report(F("Sequence x8 (chain)"), *sequence8);
+	Report(F("Sequence x8 (N-ary)"), SyncSequenceOf(ramp, sine, triangular, sine, triangular, sine, triangular, sine));
+
+	Serial.println(F("-- Composite"));
+	ResetArena();
+	auto ramp150 = SyncRamp(150);
+	auto constant300 = SyncConstant(300, 1.0);
+	auto zeros200 = SyncZeros(200);
+	auto rampConstant = ramp150 + constant300;
+	auto sequence = rampConstant + zeros200;
+	auto& compound = sequence.Repeat(3).ScaleY(3.0);
+	Report(F("Compound"), compound);
+	auto& deep = compound.OffsetY(0.2).Inverse().ScaleY(0.5).Speed(2.0).Mirroring().Repeat();
+	Report(F("Deep"), deep);
+	ReportAllocations(F("Deep"));
+
+	// Same pattern, baked once and played back from a table
+	static uint8_t table[64];
+	SyncWavetable<uint8_t> wavetable(compound, table, sizeof(table));
+	Report(F("Compound (wavetable)"), wavetable);
+
+	// Same pattern, flattened into instructions
+	static SyncStaticProgram<16> program;
+	program.Compile(deep);
+	Report(F("Deep (program)"), program);
+	Serial.print(F("Deep (program)\t"));
+	Serial.print(program.GetSize() * SyncProgram::BytesPerNode);
+	Serial.println(F(" bytes"));
+
+	// GetValue() including the clock read, with the injected clock
+	SyncClock::SetSource(MockClock);
+	deep.Restart();
+	const unsigned long start = micros();
+	for (unsigned long sample = 0; sample < Samples; sample++)
+	{
+		mockMillis++;
+		sink = deep.GetValue();
+	}
+	Serial.print(F("Deep GetValue()\t"));
+	Serial.print((micros() - start) * 1000UL / Samples);
+	Serial.println(F(" ns/sample"));
+	SyncClock::SetSource(millis);
+
+	// Fixed point, without float operations. SyncMulQ16 is built from 16 bits products
+	Serial.println(F("-- Fixed point"));
+	volatile int32_t factor = SyncToQ16(0.75);
+	const unsigned long mulStart = micros();
+	for (unsigned long sample = 0; sample < Samples; sample++) sinkQ16 = SyncMulQ16(factor, static_cast<int32_t>(sample) << 6);
+	Serial.print(F("SyncMulQ16\t"));
+	Serial.print((micros() - mulStart) * 1000UL / Samples);
+	Serial.println(F(" ns/sample"));
+	ReportQ16(F("Compound"), compound);
+	ReportQ16(F("Deep"), deep);
+
+	// Graph of the deep pattern, with the cost of each node if SYNC_INSTRUMENTATION is defined as 1
+	Serial.println(F("-- Graph"));
+	SyncDump(deep, Serial);
+}
+
+void loop()
+{
+
+}
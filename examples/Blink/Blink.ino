@@ -7,7 +7,7 @@ Unless required by applicable law or agreed to in writing, software distributed
 
 #include "SyncWaveforms.h"
 
-auto pwm = SyncStep(1000).Repeat();
+auto pwm = SyncInline(SyncStep(1000)).Repeat();
 
 void setup() 
 {
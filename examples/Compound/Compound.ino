@@ -16,7 +16,7 @@ void setup()
 	auto ramp = SyncRamp(150);
 	auto constant = SyncConstant(300, 1.0);
 	auto zeros = SyncZeros(200);
-	auto compound = (ramp + constant + zeros).Repeat(3).ScaleY(3.0);
+	auto compound = (SyncInline(ramp) + constant + zeros).Repeat(3).ScaleY(3.0);
 
 	auto endMillis = millis() + 2000;
 	while (millis() < endMillis)
@@ -24,7 +24,6 @@ void setup()
 		Serial.println(compound.GetValue());
 	}
 }
-}
 
 void loop() 
 {
@@ -0,0 +1,45 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+
+// Three LEDs, the outputs are only written when their 8 bits code changes
+const uint8_t Pins[3] = { 9, 10, 11 };
+SyncAnalogWriteDevice<3> leds(Pins);
+SyncOutput<3> output(leds);
+
+SyncChannelSet<3> channels;
+
+auto slow = SyncTriangular(4000);
+auto& breathing = slow.Repeat();
+auto steps = SyncStep(1000);
+auto& blink = steps.Repeat();
+auto fade = SyncRamp(10000);
+
+void setup()
+{
+	Serial.begin(115200);
+
+	for (uint8_t channel = 0; channel < 3; channel++) pinMode(Pins[channel], OUTPUT);
+
+	channels.Attach(0, breathing);
+	channels.Attach(1, blink);
+	channels.Attach(2, fade);
+}
+
+void loop()
+{
+	if (channels.Update()) output.Write(channels.Values);
+
+	static unsigned long lastReport = 0;
+	if (millis() - lastReport >= 1000)
+	{
+		lastReport = millis();
+		Serial.print(output.GetSavedPerSecond());
+		Serial.println(F(" writes saved per second"));
+	}
+}
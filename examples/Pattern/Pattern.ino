@@ -0,0 +1,65 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+
+// SyncTriangular(500).Repeat(), encoded with extras/SyncPattern.py
+const uint8_t breathe[] PROGMEM = { 0x53, 0x57, 0x01, 0x02, 0x15, 0xF4, 0x03, 0x07, 0xF4, 0x03, 0xFA, 0x01, 0xFA, 0x01, 0xAD };
+
+SyncStaticProgram<32> program;
+
+void setup()
+{
+	while (!Serial) { ; }
+
+	Serial.begin(115200);
+
+	// Round trip: encode a graph and load it back
+	auto ramp = SyncRamp(150);
+	auto constant = SyncConstant(300, 1.0);
+	auto zeros = SyncZeros(200);
+	auto rampConstant = ramp + constant;
+	auto sequence = rampConstant + zeros;
+	auto& compound = sequence.Repeat(3).ScaleY(3.0);
+
+	SyncStaticProgram<32> compiled(compound);
+	uint8_t buffer[64];
+	const size_t size = SyncPatternEncode(compiled, buffer, sizeof(buffer));
+
+	for (size_t i = 0; i < size; i++)
+	{
+		if (buffer[i] < 0x10) Serial.print('0');
+		Serial.print(buffer[i], HEX);
+		Serial.print(' ');
+	}
+	Serial.println();
+
+	SyncMemoryReader reader(buffer, size);
+	bool equal = SyncPatternLoad(reader, program);
+	for (unsigned long elapsed = 0; equal && elapsed <= compound.Interval; elapsed++)
+	{
+		equal = program.GetValue(elapsed) == compound.GetValue(elapsed);
+	}
+	Serial.println(equal ? F("Round trip OK") : F("Round trip FAILED"));
+
+	// Pattern stored in flash
+	SyncMemoryReader flash(breathe, sizeof(breathe), true);
+	if (SyncPatternLoad(flash, program)) program.Restart();
+}
+
+void loop()
+{
+	// Send a new pattern through the serial port to replace the current one
+	if (Serial.available())
+	{
+		SyncStreamReader stream(Serial);
+		if (SyncPatternLoad(stream, program)) program.Restart();
+		else Serial.println(F("Invalid pattern"));
+	}
+
+	analogWrite(LED_BUILTIN, program.GetCode(8));
+}
@@ -0,0 +1,74 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+
+const int LedPin = 9;
+
+// Patterns are built alternately in two arenas, so the one being played is never overwritten
+SyncStaticArena<256> arenas[2];
+uint8_t building = 0;
+
+SyncPlayer player;
+
+SyncFunction& Build(uint8_t pattern)
+{
+	SyncArena::Use(arenas[building]);
+	arenas[building].Reset();
+
+	auto& ramp = SyncNew<SyncTriangular>(500 + 250 * pattern);
+	return ramp.Repeat();
+}
+
+void Output()
+{
+	analogWrite(LedPin, SyncQ16ToCode(player.UpdateQ16(millis()), 8));
+}
+
+#if defined(__AVR_ATmega328P__)
+// 1 kHz timer interrupt
+ISR(TIMER2_COMPA_vect)
+{
+	Output();
+}
+#endif
+
+void setup()
+{
+	pinMode(LedPin, OUTPUT);
+
+	player.Publish(Build(0), 0, false);
+	building = 1;
+
+#if defined(__AVR_ATmega328P__)
+	TCCR2A = _BV(WGM21);
+	TCCR2B = _BV(CS22);
+	OCR2A = 249;
+	TIMSK2 = _BV(OCIE2A);
+#endif
+}
+
+void loop()
+{
+	static uint8_t pattern = 0;
+	static unsigned long lastChange = 0;
+
+#if !defined(__AVR_ATmega328P__)
+	Output();
+#endif
+
+	// A new pattern every 5 seconds, crossfading for 300 ms at the end of the current period
+	if (millis() - lastChange > 5000 && !player.IsPending())
+	{
+		lastChange = millis();
+		pattern = (pattern + 1) % 4;
+		player.Publish(Build(pattern), 300);
+	}
+
+	// Once the ISR does not use the previous pattern anymore, its arena can be rebuilt
+	if (player.TakeRetired() != nullptr) building = 1 - building;
+}
@@ -0,0 +1,31 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+
+// Two channels sampled every 2 ms, sent as binary frames instead of printing floats
+// Capture them on the computer with: python3 extras/SyncTelemetry.py /dev/ttyUSB0 --baud 500000 > trace.csv
+auto sine = SyncSin(1000);
+auto& wave = sine.Repeat();
+auto pulse = SyncStep(100, 300);
+auto& pulses = pulse.Repeat();
+
+SyncTelemetry<2, 64> telemetry(Serial, 2, 8, 16);
+
+void setup()
+{
+	Serial.begin(500000);
+
+	telemetry.Attach(0, wave);
+	telemetry.Attach(1, pulses);
+}
+
+void loop()
+{
+	telemetry.Sample();
+	telemetry.Send();
+}
@@ -13,7 +13,7 @@ void setup()
 
 	Serial.begin(115200);
 
-	auto sin = SyncSin(1000).Repeat();
+	auto sin = SyncInline(SyncSin(1000)).Repeat();
 	auto trigger = SyncTrapezium(150, 150, 150);
 
 	auto newMillis = millis();
@@ -22,7 +22,7 @@ void setup()
 	while(newMillis < endMillis)
 	{
 		newMillis = millis();
-		Serial.println(max(sin.GetValue() * 0.5, trigger.GetValue()));
+		Serial.println(max(sin.GetValueAt(newMillis) * 0.5, trigger.GetValueAt(newMillis)));
 		
 		// just some timig to show restart and reset
 		if(newMillis - lastMillis > 3000)
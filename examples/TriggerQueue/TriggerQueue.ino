@@ -0,0 +1,56 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+
+const int ButtonPin = 2;
+const int LedPin = 9;
+
+// The flash starts at the instant the button was pressed, even if the main loop is busy
+// It is the brightest of a short pulse and a slow glow, both restarted by each press
+auto pulse = SyncTrapezium(20, 100, 400);
+auto glow = SyncInline(SyncInverseRamp(1500)).ScaleY(0.3);
+SyncMax flash(pulse, glow);
+
+SyncTriggerQueue<8> queue;
+SyncChannelSet<1> channels(10);
+
+void OnButton()
+{
+	queue.Post(0);
+}
+
+void setup()
+{
+	Serial.begin(115200);
+
+	pinMode(ButtonPin, INPUT_PULLUP);
+	pinMode(LedPin, OUTPUT);
+	attachInterrupt(digitalPinToInterrupt(ButtonPin), OnButton, FALLING);
+
+	channels.Attach(0, flash);
+}
+
+void loop()
+{
+	if (channels.Update(queue))
+	{
+		analogWrite(LedPin, channels.Values[0] * 255);
+	}
+
+	static unsigned long lastReport = 0;
+	if (millis() - lastReport > 5000)
+	{
+		lastReport = millis();
+		Serial.print(F("Latency (ms) last "));
+		Serial.print(channels.GetLastEventLatency());
+		Serial.print(F(" max "));
+		Serial.print(channels.GetMaxEventLatency());
+		Serial.print(F(" dropped "));
+		Serial.println(queue.GetDropped());
+	}
+}
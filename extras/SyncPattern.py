@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+# Copyright (c) 2019 Luis Llamas
+# (www.luisllamas.es)
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+
+"""Encodes patterns in the binary format of SyncPatternLoad (src/SyncPattern.h) on the PC.
+
+    python3 SyncPattern.py "Triangular(500).Repeat()" --name breathe       (C array for PROGMEM)
+    python3 SyncPattern.py "Ramp(150).ScaleY(0.5).Repeat(3)" --output ramp.bin
+    python3 SyncPattern.py "fade=Ramp(300).Inverse()" "pulse=Step(50, 1000).Repeat()" --header Patterns.h
+    python3 SyncPattern.py "Sin(1000, fast=True).Repeat()" --port /dev/ttyUSB0   (needs pyserial)
+
+Patterns are written with the same names as the library: functions (Zeros, Constant, Step, Ramp,
+InverseRamp, Triangular, Trapezium, Sin, Cos), transformations (Speed, ScaleY, OffsetY, AffineY,
+SliceX, Delay, Inverse, Reverse, Repeat, Mirroring), operations (Add, Substract, Max, Min, And, Or)
+and + to concatenate. Several patterns can be given as name=expression.
+"""
+
+import argparse
+import re
+import struct
+
+VERSION = 1
+FAST = 0x80
+
+# SyncNodeType
+ZEROS, CONSTANT, STEP, RAMP, INVERSE_RAMP, TRIANGULAR, TRAPEZIUM, SIN, COS = 1, 2, 4, 5, 6, 7, 8, 9, 10
+SPEED, SCALE_Y, OFFSET_Y, AFFINE_Y, SLICE_X, DELAY, INVERSE, REVERSE = 12, 13, 14, 15, 16, 17, 18, 19
+REPEAT_N, REPEAT_INFINITE, MIRRORING = 20, 21, 22
+ADD, SUBSTRACT, MAX, MIN, AND, OR, CONCATENATE = 23, 24, 25, 26, 27, 28, 29
+
+
+def float32(value):
+    return struct.unpack("<f", struct.pack("<f", value))[0]
+
+
+class Node:
+    """One node of a graph, with the Interval the library computes for it."""
+
+    def __init__(self, code, interval, unsigned=(), signed=(), floats=(), children=(), fast=False):
+        self.code = code
+        self.interval = interval & 0xFFFFFFFF
+        self.unsigned = unsigned
+        self.signed = signed
+        self.floats = floats
+        self.children = children
+        self.fast = fast
+
+    def Speed(self, factor):
+        return Node(SPEED, int(float32(self.interval) / float32(factor)), floats=(factor,), children=(self,))
+
+    def ScaleY(self, factor):
+        return Node(SCALE_Y, self.interval, floats=(factor,), children=(self,))
+
+    def OffsetY(self, offset):
+        return Node(OFFSET_Y, self.interval, floats=(offset,), children=(self,))
+
+    def AffineY(self, factor, offset):
+        return Node(AFFINE_Y, self.interval, floats=(factor, offset), children=(self,))
+
+    def SliceX(self, offset):
+        return Node(SLICE_X, self.interval, signed=(offset,), children=(self,))
+
+    def Delay(self, delay):
+        return Node(DELAY, self.interval + delay, unsigned=(delay,), children=(self,))
+
+    def Inverse(self):
+        return Node(INVERSE, self.interval, children=(self,))
+
+    def Reverse(self):
+        return Node(REVERSE, self.interval, children=(self,))
+
+    def Repeat(self, repetitions=None):
+        if repetitions is None:
+            return Node(REPEAT_INFINITE, self.interval, children=(self,))
+        if not 0 <= repetitions <= 255:
+            raise ValueError("at most 255 repetitions")
+        return Node(REPEAT_N, self.interval * repetitions, unsigned=(repetitions,), children=(self,))
+
+    def Mirroring(self):
+        return Node(MIRRORING, self.interval * 2, children=(self,))
+
+    def __add__(self, other):
+        return Node(CONCATENATE, self.interval + other.interval, children=(self, other))
+
+
+def Zeros(t):
+    return Node(ZEROS, t)
+
+
+def Constant(t, value):
+    return Node(CONSTANT, t, floats=(value,))
+
+
+def Step(t0, t=None):
+    return Node(STEP, t0, unsigned=(t0 // 2,)) if t is None else Node(STEP, t, unsigned=(t0,))
+
+
+def Ramp(t):
+    return Node(RAMP, t)
+
+
+def InverseRamp(t):
+    return Node(INVERSE_RAMP, t)
+
+
+def Triangular(t0, t1=None):
+    if t1 is None:
+        t0, t1 = t0 // 2, t0 - t0 // 2
+    return Node(TRIANGULAR, t0 + t1, unsigned=(t0, t1))
+
+
+def Trapezium(t0, t1=None, t2=None):
+    if t1 is None:
+        t0, t1, t2 = t0 // 3, t0 // 3, t0 - 2 * (t0 // 3)
+    return Node(TRAPEZIUM, t0 + t1 + t2, unsigned=(t0, t1, t2))
+
+
+def Sin(t, fast=False):
+    return Node(SIN, t, fast=fast)
+
+
+def Cos(t, fast=False):
+    return Node(COS, t, fast=fast)
+
+
+# Operands start with the operation, so their time offsets are 0
+def _operation(code):
+    return lambda op1, op2: Node(code, max(op1.interval, op2.interval), signed=(0, 0), children=(op1, op2))
+
+
+Add, Substract, Max, Min, And, Or = (_operation(code) for code in (ADD, SUBSTRACT, MAX, MIN, AND, OR))
+
+
+def _varint(value):
+    data = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value == 0:
+            data.append(byte)
+            return data
+        data.append(byte | 0x80)
+
+
+def _nodes(node):
+    yield node
+    for child in node.children:
+        yield from _nodes(child)
+
+
+def encode(root):
+    """Bytes of the pattern, the same SyncPatternEncode writes for the compiled graph."""
+    nodes = list(_nodes(root))
+    if len(nodes) > 255:
+        raise ValueError("at most 255 nodes")
+
+    data = bytearray(b"SW") + bytes((VERSION, len(nodes)))
+    for node in nodes:
+        data.append(node.code | (FAST if node.fast else 0))
+        data += _varint(node.interval)
+        for value in node.unsigned:
+            data += _varint(value & 0xFFFFFFFF)
+        for value in node.signed:
+            data += _varint(((value << 1) ^ (value >> 31)) & 0xFFFFFFFF)
+        for value in node.floats:
+            data += struct.pack("<f", value)
+    data.append(sum(data) & 0xFF)
+    return bytes(data)
+
+
+def parse(expression):
+    names = {name: value for name, value in globals().items() if name[:1].isupper()}
+    return eval(expression, {"__builtins__": {}}, names)
+
+
+def c_array(name, data):
+    return "const uint8_t %s[] PROGMEM = { %s };" % (name, ", ".join("0x%02X" % byte for byte in data))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Encodes patterns for SyncPatternLoad")
+    parser.add_argument("patterns", nargs="+", help="expression, or name=expression")
+    parser.add_argument("--name", default="pattern", help="name of the C array of an unnamed pattern")
+    parser.add_argument("--output", help="writes the bytes of the pattern to a file")
+    parser.add_argument("--header", help="writes the C arrays to a file instead of the standard output")
+    parser.add_argument("--port", help="sends the pattern to a serial port")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    encoded = []
+    for pattern in args.patterns:
+        match = re.match(r"^(\w+)=(.*)$", pattern)
+        name, expression = (match.group(1), match.group(2)) if match else (args.name, pattern)
+        encoded.append((name, expression, encode(parse(expression))))
+
+    if args.output or args.port:
+        if len(encoded) != 1:
+            parser.error("only one pattern can be written or sent")
+        data = encoded[0][2]
+        if args.output:
+            with open(args.output, "wb") as output:
+                output.write(data)
+        if args.port:
+            import serial
+            with serial.Serial(args.port, args.baud) as port:
+                port.write(data)
+        return
+
+    lines = []
+    for name, expression, data in encoded:
+        lines += ["// %s" % expression, c_array(name, data)]
+    if args.header:
+        with open(args.header, "w") as header:
+            header.write("\n".join(lines) + "\n")
+    else:
+        print("\n".join(lines))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# Copyright (c) 2019 Luis Llamas
+# (www.luisllamas.es)
+# Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+
+"""Decodes the binary frames of SyncTelemetry (src/SyncTelemetry.h) into CSV rows.
+
+    python3 SyncTelemetry.py capture.bin > trace.csv
+    python3 SyncTelemetry.py /dev/ttyUSB0 --baud 1000000 > trace.csv   (needs pyserial)
+
+Each row is the time of the sample (SyncClock ticks) and the value of every channel (0.0 - 1.0).
+Corrupted frames are skipped, and lost frames or samples are reported on stderr.
+"""
+
+import argparse
+import sys
+
+VERSION = 1
+ESCAPE = 0x80
+HEADER_SIZE = 15
+
+
+class Decoder:
+    """Feed bytes as they arrive, get (time, [values]) samples back."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.sequence = None
+        self.next_time = None
+        self.lost_frames = 0
+        self.lost_samples = 0
+        self.bad_frames = 0
+
+    def feed(self, data):
+        self.buffer += data
+        samples = []
+        while True:
+            start = self.buffer.find(b"ST")
+            if start < 0:
+                del self.buffer[:-1]
+                return samples
+            del self.buffer[:start]
+            if len(self.buffer) < HEADER_SIZE:
+                return samples
+
+            result = self._parse()
+            if result is None:
+                return samples
+            if result is False:
+                # Not a frame, resynchronize after the false start
+                self.bad_frames += 1
+                del self.buffer[:1]
+                continue
+            samples += result
+
+    def _parse(self):
+        b = self.buffer
+        version, sequence, channels, bits, count = b[2], b[3], b[4], b[5], b[6]
+        if version != VERSION or bits not in (8, 16) or channels == 0 or count == 0:
+            return False
+        time = int.from_bytes(b[7:11], "little")
+        period = int.from_bytes(b[11:15], "little")
+        size = bits // 8
+        maximum = (1 << bits) - 1
+
+        position = HEADER_SIZE
+        codes = []
+        previous = [0] * channels
+        for sample in range(count):
+            row = []
+            for channel in range(channels):
+                if position >= len(b):
+                    return None
+                if sample > 0 and b[position] != ESCAPE:
+                    delta = b[position] - 256 if b[position] > 127 else b[position]
+                    code = previous[channel] + delta
+                    position += 1
+                else:
+                    if sample > 0:
+                        position += 1
+                    if position + size > len(b):
+                        return None
+                    code = int.from_bytes(b[position:position + size], "little")
+                    position += size
+                if code < 0 or code > maximum:
+                    return False
+                row.append(code)
+                previous[channel] = code
+            codes.append(row)
+
+        if position >= len(b):
+            return None
+        if sum(b[:position]) & 0xFF != b[position]:
+            return False
+        del self.buffer[:position + 1]
+
+        if self.sequence is not None and sequence != (self.sequence + 1) & 0xFF:
+            self.lost_frames += (sequence - self.sequence - 1) & 0xFF
+        if self.next_time is not None and period > 0 and time != self.next_time:
+            self.lost_samples += ((time - self.next_time) & 0xFFFFFFFF) // period
+        self.sequence = sequence
+        self.next_time = (time + count * period) & 0xFFFFFFFF
+
+        return [((time + i * period) & 0xFFFFFFFF, [code / maximum for code in row]) for i, row in enumerate(codes)]
+
+
+def open_source(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial
+        return serial.Serial(path, baud, timeout=1)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decodes SyncTelemetry frames into CSV")
+    parser.add_argument("source", help="capture file, serial port or - for stdin")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    decoder = Decoder()
+    source = open_source(args.source, args.baud)
+    header = False
+    try:
+        while True:
+            data = source.read(256)
+            if not data:
+                if hasattr(source, "in_waiting"):
+                    continue
+                break
+            for time, values in decoder.feed(data):
+                if not header:
+                    header = True
+                    print("time," + ",".join("ch%d" % i for i in range(len(values))))
+                print("%d,%s" % (time, ",".join("%.5f" % v for v in values)))
+    except KeyboardInterrupt:
+        pass
+
+    print("lost frames %d, lost samples %d, bad frames %d" % (decoder.lost_frames, decoder.lost_samples, decoder.bad_frames), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
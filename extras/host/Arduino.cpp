@@ -0,0 +1,31 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "Arduino.h"
+
+#include <chrono>
+#include <thread>
+
+HostSerial Serial;
+volatile uint8_t HostStatusRegister = 0x80;
+
+static const std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+
+unsigned long millis()
+{
+	return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - Start).count());
+}
+
+unsigned long micros()
+{
+	return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count());
+}
+
+void delay(unsigned long ms)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
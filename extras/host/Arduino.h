@@ -0,0 +1,166 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+// Minimal Arduino API for the host (Linux) build of the library, the tests and the benchmark
+// Only what the library and its examples use. Time comes from the steady clock of the host
+
+#ifndef _SYNC_HOST_ARDUINO_h
+#define _SYNC_HOST_ARDUINO_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define PI 3.1415926535897932384626433832795
+
+#define PROGMEM
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t*>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t*>(address))
+#define pgm_read_dword(address) (*reinterpret_cast<const uint32_t*>(address))
+#define pgm_read_float(address) (*reinterpret_cast<const float*>(address))
+
+class __FlashStringHelper;
+#define F(string) (reinterpret_cast<const __FlashStringHelper*>(string))
+
+// Functions instead of the macros of the AVR core, so they do not collide with the standard library
+template<typename A, typename B>
+auto min(const A& a, const B& b) -> decltype(b < a ? b : a) { return b < a ? b : a; }
+
+template<typename A, typename B>
+auto max(const A& a, const B& b) -> decltype(a < b ? b : a) { return a < b ? b : a; }
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define LED_BUILTIN 13
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline void analogWrite(uint8_t, int) {}
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+
+// Status register of the AVR boards, its I bit (0x80) enables the interrupts
+extern volatile uint8_t HostStatusRegister;
+#define SREG HostStatusRegister
+inline void cli() { SREG &= ~0x80; }
+inline void sei() { SREG |= 0x80; }
+inline void noInterrupts() { cli(); }
+inline void interrupts() { sei(); }
+
+#define DEC 10
+#define HEX 16
+
+class Print
+{
+public:
+	virtual ~Print() {}
+
+	virtual size_t write(uint8_t c) = 0;
+
+	virtual size_t write(const uint8_t* buffer, size_t size)
+	{
+		size_t n = 0;
+		while (size--) n += write(*buffer++);
+		return n;
+	}
+
+	size_t write(const char* text) { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+
+	size_t print(const __FlashStringHelper* text) { return write(reinterpret_cast<const char*>(text)); }
+	size_t print(const char* text) { return write(text); }
+	size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+	size_t print(unsigned char value, int base = DEC) { return print(static_cast<unsigned long>(value), base); }
+	size_t print(int value, int base = DEC) { return print(static_cast<long>(value), base); }
+	size_t print(unsigned int value, int base = DEC) { return print(static_cast<unsigned long>(value), base); }
+
+	size_t print(long value, int base = DEC)
+	{
+		if (base == DEC) return Format("%ld", value);
+		return print(static_cast<unsigned long>(value), base);
+	}
+
+	size_t print(unsigned long value, int base = DEC)
+	{
+		return Format(base == HEX ? "%lX" : "%lu", value);
+	}
+
+	size_t print(double value, int digits = 2)
+	{
+		char buffer[40];
+		snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+		return write(buffer);
+	}
+
+	size_t println() { return write("\r\n"); }
+
+	template<typename T>
+	size_t println(T value) { return print(value) + println(); }
+
+	template<typename T>
+	size_t println(T value, int format) { return print(value, format) + println(); }
+
+private:
+	template<typename T>
+	size_t Format(const char* format, T value)
+	{
+		char buffer[24];
+		snprintf(buffer, sizeof(buffer), format, value);
+		return write(buffer);
+	}
+};
+
+class Stream : public Print
+{
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+
+	size_t readBytes(uint8_t* buffer, size_t length)
+	{
+		size_t count = 0;
+		while (count < length)
+		{
+			const int c = read();
+			if (c < 0) break;
+			buffer[count++] = static_cast<uint8_t>(c);
+		}
+		return count;
+	}
+
+	size_t readBytes(char* buffer, size_t length) { return readBytes(reinterpret_cast<uint8_t*>(buffer), length); }
+};
+
+// Serial writes to the standard output and never receives
+class HostSerial : public Stream
+{
+public:
+	void begin(unsigned long) {}
+	operator bool() const { return true; }
+
+	size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+	using Print::write;
+
+	int available() override { return 0; }
+	int read() override { return -1; }
+};
+
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,46 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+// Runs the Benchmark example on the host. The arena allocations of every class are printed by the sketch,
+// the heap allocations are counted here, so nodes that skip the arena show up too
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+
+static unsigned long HeapAllocations = 0;
+
+void* operator new(size_t size)
+{
+	HeapAllocations++;
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == nullptr) throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+#include "../../examples/Benchmark/Benchmark.ino"
+
+// The arena of the sketch must fit every section, fail instead of waiting forever
+static void ArenaFull(SyncArena& full, size_t size)
+{
+	printf("Arena full, %u more bytes needed\n", static_cast<unsigned>(size));
+	exit(1);
+}
+
+int main()
+{
+	SyncArena::OverflowHandler = ArenaFull;
+	setup();
+
+	Serial.println(F("-- Heap"));
+	Serial.print(F("Allocations\t"));
+	Serial.println(HeapAllocations);
+	return 0;
+}
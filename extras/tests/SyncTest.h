@@ -0,0 +1,31 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+// Checks for the host tests, each test is a program that returns the number of failed checks
+
+#ifndef _SYNCTEST_h
+#define _SYNCTEST_h
+
+#include <stdio.h>
+#include <math.h>
+
+static int SyncTestFailures = 0;
+
+#define SYNC_CHECK(condition) \
+	do { if (!(condition)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); SyncTestFailures++; } } while (0)
+
+#define SYNC_CHECK_NEAR(value, expected, tolerance) \
+	do { const double syncValue = (value), syncExpected = (expected); \
+		if (fabs(syncValue - syncExpected) > (tolerance)) { printf("%s:%d: %s is %f, expected %f\n", __FILE__, __LINE__, #value, syncValue, syncExpected); SyncTestFailures++; } } while (0)
+
+#define SYNC_TEST_RESULT() (printf(SyncTestFailures == 0 ? "OK\n" : "%d checks failed\n", SyncTestFailures), SyncTestFailures)
+
+// Mock clock, so the tests run at known instants
+static unsigned long SyncTestMillis = 0;
+inline unsigned long SyncTestClock() { return SyncTestMillis; }
+
+#endif
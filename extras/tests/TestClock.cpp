@@ -0,0 +1,43 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+
+	// Functions start at the time of the injected clock
+	SyncTestMillis = 1000;
+	auto ramp = SyncRamp(100);
+	SyncTestMillis = 1050;
+	SYNC_CHECK_NEAR(ramp.GetValue(), 0.5, 1e-6);
+	SYNC_CHECK(ramp.GetElapsed() == 50);
+
+	// Restart takes the current time of the clock
+	ramp.Restart();
+	SyncTestMillis = 1075;
+	SYNC_CHECK_NEAR(ramp.GetValue(), 0.25, 1e-6);
+
+	// Elapsed times survive the 32 bits wraparound of the clock
+	SyncTestMillis = 0xFFFFFFF0UL;
+	auto pulse = SyncInline(SyncStep(10, 40)).Repeat();
+	pulse.Restart();
+	SyncTestMillis = 0x00000005UL;
+	SYNC_CHECK(SyncClock::Elapsed(0xFFFFFFF0UL, SyncTestMillis) == 21);
+	SYNC_CHECK(pulse.GetValue() == 0.0f);
+	SyncTestMillis = 0x00000020UL;
+	SYNC_CHECK(pulse.GetValue() == 1.0f);
+
+	// Several functions evaluated at one clock read
+	auto sine = SyncSin(200);
+	SYNC_CHECK(sine.GetValueAt(sine.GetStartTime() + 50) == sine.GetValue(50));
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,102 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+// The curve stays within the documented 1e-3 of its closed form, over the whole input range
+static void CheckCurve(const char* name, const SyncCurve& curve, double (*closedForm)(double))
+{
+	double worst = 0;
+	for (int i = 0; i <= 4096; i++)
+	{
+		const double x = i / 4096.0;
+		const double error = fabs(curve.Apply(x) - closedForm(x));
+		if (error > worst) worst = error;
+	}
+	if (worst > 1e-3)
+	{
+		printf("%s: max error %g\n", name, worst);
+		SyncTestFailures++;
+	}
+
+	// Inputs out of range are clamped
+	SYNC_CHECK(curve.Apply(-0.5) == curve.Apply(0.0));
+	SYNC_CHECK(curve.Apply(1.5) == curve.Apply(1.0));
+}
+
+static double Gamma(double x) { return pow(x, 2.2); }
+static double SquareRoot(double x) { return pow(x, 0.5); }
+static double ExponentialIn(double x) { return x == 0 ? 0 : pow(2, 10 * x - 10); }
+static double ExponentialOut(double x) { return x == 1 ? 1 : 1 - pow(2, -10 * x); }
+static double QuadraticIn(double x) { return x * x; }
+static double QuadraticOut(double x) { return 1 - (1 - x) * (1 - x); }
+static double QuadraticInOut(double x) { return x < 0.5 ? 2 * x * x : 1 - 2 * (1 - x) * (1 - x); }
+static double CubicIn(double x) { return x * x * x; }
+static double CubicOut(double x) { return 1 - pow(1 - x, 3); }
+static double CubicInOut(double x) { return x < 0.5 ? 4 * x * x * x : 1 - 4 * pow(1 - x, 3); }
+static double Bezier(double x) { return 3 * (1 - x) * (1 - x) * x * 0.1 + 3 * (1 - x) * x * x * 0.9 + x * x * x; }
+static double Linear(double x) { return x; }
+
+int main()
+{
+	// Tables generated at compile time
+	for (int i = 0; i <= SYNC_LOG_TABLE_SIZE; i++)
+	{
+		SYNC_CHECK(fabs(SyncLog2Table[i] - log2(1 + i / 16.0) * SYNC_Q16_ONE) <= 0.5);
+		SYNC_CHECK(fabs(SyncExp2Table[i] - (pow(2, i / 16.0) - 1) * SYNC_Q16_ONE) <= 0.5);
+	}
+
+	// Kernels, within their documented errors
+	double worstLog = 0;
+	for (int32_t value = 1; value < 4 * SYNC_Q16_ONE; value += value / 64 + 1)
+	{
+		const double error = fabs(SyncQ16ToFloat(SyncLog2Q16(value)) - log2(static_cast<double>(value) / SYNC_Q16_ONE));
+		if (error > worstLog) worstLog = error;
+	}
+	SYNC_CHECK(worstLog <= 1e-3);
+
+	double worstExp = 0;
+	for (int32_t value = -16 * SYNC_Q16_ONE; value <= 0; value += 97)
+	{
+		const double error = fabs(SyncQ16ToFloat(SyncExp2Q16(value)) - pow(2, static_cast<double>(value) / SYNC_Q16_ONE));
+		if (error > worstExp) worstExp = error;
+	}
+	SYNC_CHECK(worstExp <= 3e-4);
+
+	const double Exponents[] = { 0.5, 1.0, 2.2, 3.0 };
+	double worstPow = 0;
+	for (double exponent : Exponents)
+	{
+		for (int32_t base = 0; base <= SYNC_Q16_ONE; base += 61)
+		{
+			const double error = fabs(SyncQ16ToFloat(SyncPowQ16(base, SyncToQ16(exponent))) - pow(static_cast<double>(base) / SYNC_Q16_ONE, exponent));
+			if (error > worstPow) worstPow = error;
+		}
+	}
+	SYNC_CHECK(worstPow <= 5e-4);
+
+	// Curves
+	CheckCurve("Linear", SyncCurve(), Linear);
+	CheckCurve("Gamma 2.2", SyncCurve(SyncCurveType::Gamma, 2.2), Gamma);
+	CheckCurve("Gamma 0.5", SyncCurve(SyncCurveType::Gamma, 0.5), SquareRoot);
+	CheckCurve("ExponentialIn", SyncCurve(SyncCurveType::ExponentialIn), ExponentialIn);
+	CheckCurve("ExponentialOut", SyncCurve(SyncCurveType::ExponentialOut), ExponentialOut);
+	CheckCurve("QuadraticIn", SyncCurve(SyncCurveType::QuadraticIn), QuadraticIn);
+	CheckCurve("QuadraticOut", SyncCurve(SyncCurveType::QuadraticOut), QuadraticOut);
+	CheckCurve("QuadraticInOut", SyncCurve(SyncCurveType::QuadraticInOut), QuadraticInOut);
+	CheckCurve("CubicIn", SyncCurve(SyncCurveType::CubicIn), CubicIn);
+	CheckCurve("CubicOut", SyncCurve(SyncCurveType::CubicOut), CubicOut);
+	CheckCurve("CubicInOut", SyncCurve(SyncCurveType::CubicInOut), CubicInOut);
+	CheckCurve("Bezier", SyncCurve(SyncCurveType::Bezier, 0.1, 0.9), Bezier);
+
+	// Easing follows the curve over its Interval
+	auto easing = SyncEasing(1000, SyncCurve(SyncCurveType::CubicInOut));
+	for (unsigned long t = 0; t <= 1000; t += 7) SYNC_CHECK_NEAR(easing.GetValue(t), CubicInOut(t / 1000.0), 1e-3);
+
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,47 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+// The fast SyncSin and SyncCos stay within the documented 5e-5 + 3.7e-10 * t of sin() and cos()
+static void CheckFastTrig(unsigned long interval)
+{
+	SyncSin sine(interval, true);
+	SyncCos cosine(interval, true);
+	const unsigned long step = interval / 5000 + 1;
+	double worst = 0;
+
+	for (unsigned long t = 0; t <= interval; t += step)
+	{
+		const double angle = 2 * M_PI * static_cast<double>(t) / interval;
+		const double bound = 5e-5 + 3.7e-10 * t;
+		const double sinError = fabs(sine.GetValue(t) - (0.5 * sin(angle) + 0.5));
+		const double cosError = fabs(cosine.GetValue(t) - (0.5 * cos(angle) + 0.5));
+		if (sinError > bound || cosError > bound)
+		{
+			printf("interval %lu, t %lu: errors %g %g over %g\n", interval, t, sinError, cosError, bound);
+			SyncTestFailures++;
+			return;
+		}
+		if (sinError > worst) worst = sinError;
+		if (cosError > worst) worst = cosError;
+	}
+	printf("interval %lu: max error %g\n", interval, worst);
+}
+
+int main()
+{
+	const unsigned long Intervals[] = { 1, 2, 3, 7, 100, 1000, 4567, 65535,
+#if !SYNC_SHORT_INTERVALS
+		1000000UL, 86400000UL, 0xFFFFFFFFUL
+#endif
+	};
+	for (unsigned long interval : Intervals) CheckFastTrig(interval);
+
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,93 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include <stdlib.h>
+#include <new>
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+// Heap allocations, inline patterns must not make any
+static unsigned long HeapAllocations = 0;
+
+void* operator new(size_t size)
+{
+	HeapAllocations++;
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (memory == nullptr) throw std::bad_alloc();
+	return memory;
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+// An inline pattern is one object, the size of its nodes
+typedef decltype(SyncPWM(300, 1000)) SyncTestPWM;
+static_assert(sizeof(SyncTestPWM) == sizeof(SyncStep) + sizeof(SyncRepeatInfinite), "SyncPWM is not the size of its nodes");
+
+// True if the node is stored inside the pattern
+template<typename T>
+static bool IsInside(const SyncFunction* node, const T& pattern)
+{
+	const char* address = reinterpret_cast<const char*>(node);
+	const char* start = reinterpret_cast<const char*>(&pattern);
+	return address >= start && address < start + sizeof(T);
+}
+
+// Compound of the examples: 150 ms ramp, 300 ms at 1.0 and 200 ms at 0, three times, scaled by 3
+template<typename T>
+static void CheckCompound(T& compound)
+{
+	SYNC_CHECK(compound.Interval == 1950);
+	SYNC_CHECK_NEAR(compound.GetValue(75), 1.5, 1e-5);
+	SYNC_CHECK_NEAR(compound.GetValue(650 + 300), 3.0, 1e-5);
+	SYNC_CHECK_NEAR(compound.GetValue(1300 + 600), 0.0, 1e-5);
+	SYNC_CHECK_NEAR(compound.GetValue(2000), 0.0, 1e-5);
+}
+
+SyncStaticArena<256> arena;
+
+int main()
+{
+	SyncArena::Use(arena);
+	const unsigned long heapBefore = HeapAllocations;
+
+	auto ramp = SyncRamp(150);
+	auto constant = SyncConstant(300, 1.0);
+	auto zeros = SyncZeros(200);
+	auto compound = (SyncInline(ramp) + constant + zeros).Repeat(3).ScaleY(3.0);
+	static_assert(sizeof(compound) == 2 * sizeof(SyncConcatenate) + sizeof(SyncRamp) + sizeof(SyncConstant) + sizeof(SyncZeros)
+		+ sizeof(SyncRepeatN) + sizeof(SyncTransformationScaleY), "The compound is not the size of its nodes");
+	CheckCompound(compound);
+
+	auto pwm = SyncPWM(300, 1000);
+	SYNC_CHECK(pwm.GetValue(100) == 1.0f);
+	SYNC_CHECK(pwm.GetValue(1500) == 0.0f);
+	SYNC_CHECK(IsInside(pwm.GetChild(0), pwm));
+
+	// Neither the arena nor the heap are used
+	SYNC_CHECK(arena.Allocations == 0);
+	SYNC_CHECK(arena.GetUsed() == 0);
+	SYNC_CHECK(HeapAllocations == heapBefore);
+
+	// Copies point to their own operands, and keep working once the original is gone
+	auto* original = new decltype(compound)(compound);
+	auto copy = *original;
+	SYNC_CHECK(IsInside(copy.GetChild(0), copy));
+	SYNC_CHECK(IsInside(copy.GetChild(0)->GetChild(0), copy));
+	SYNC_CHECK(IsInside(copy.GetChild(0)->GetChild(0)->GetChild(0)->GetChild(1), copy));
+	delete original;
+	CheckCompound(copy);
+
+	// Each copy can change on its own
+	auto scaled = copy;
+	scaled.SetScaleFactor(1.0);
+	SYNC_CHECK_NEAR(scaled.GetValue(75), 0.5, 1e-5);
+	SYNC_CHECK_NEAR(copy.GetValue(75), 1.5, 1e-5);
+
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,101 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+// Counts its evaluations, its output is Level whatever the time
+class SyncCounting : public SyncFunction
+{
+public:
+	SyncCounting(bool cacheable) : SyncFunction(1000), Cacheable(cacheable) {}
+
+	float Level = 0.5;
+	bool Cacheable;
+	unsigned int Calls = 0;
+	unsigned int CallsQ16 = 0;
+
+	bool IsCacheable() const override { return Cacheable; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		Calls++;
+		return Level;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		CallsQ16++;
+		return SyncToQ16(Level);
+	}
+};
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+
+	// Cached for the same frame and elapsed time only
+	SyncCounting counting(true);
+	SyncMemo memo(counting);
+	SYNC_CHECK(memo.GetValue(100) == 0.5f);
+	counting.Level = 0.7;
+	SYNC_CHECK(memo.GetValue(100) == 0.5f);
+	SYNC_CHECK(counting.Calls == 1);
+	SYNC_CHECK(memo.GetValue(101) == 0.7f);
+	SYNC_CHECK(counting.Calls == 2);
+	counting.Level = 0.9;
+	SyncClock::NextFrame();
+	SYNC_CHECK(memo.GetValue(101) == 0.9f);
+	SYNC_CHECK(counting.Calls == 3);
+
+	// Going back to a previous time evaluates again
+	SYNC_CHECK(memo.GetValue(100) == 0.9f);
+	SYNC_CHECK(counting.Calls == 4);
+
+	// Float and Q16 values are cached apart
+	SYNC_CHECK(memo.GetValueQ16(100) == SyncToQ16(0.9));
+	SYNC_CHECK(memo.GetValueQ16(100) == SyncToQ16(0.9));
+	SYNC_CHECK(counting.CallsQ16 == 1);
+	SYNC_CHECK(counting.Calls == 4);
+
+	// Reset drops the cached values
+	counting.Level = 0.1;
+	memo.Reset();
+	SYNC_CHECK(memo.GetValue(100) == 0.1f);
+	SYNC_CHECK(memo.GetValueQ16(100) == SyncToQ16(0.1));
+	SYNC_CHECK(counting.Calls == 5);
+	SYNC_CHECK(counting.CallsQ16 == 2);
+
+	// A shared operand is evaluated once per instant, whatever the number of parents
+	SyncClock::NextFrame();
+	SyncAdd sum(memo, memo);
+	SyncMax maximum(sum, memo);
+	SYNC_CHECK_NEAR(maximum.GetValue(200), 0.2, 1e-6);
+	SYNC_CHECK(counting.Calls == 6);
+
+	// Operands with state are never cached
+	SyncCounting state(false);
+	SyncMemo stateMemo(state);
+	stateMemo.GetValue(100);
+	stateMemo.GetValue(100);
+	stateMemo.GetValueQ16(100);
+	stateMemo.GetValueQ16(100);
+	SYNC_CHECK(state.Calls == 2);
+	SYNC_CHECK(state.CallsQ16 == 2);
+	auto delta = SyncDelta(100);
+	SyncMemo deltaMemo(delta);
+	SYNC_CHECK(!deltaMemo.IsCacheable());
+
+	// Changing the operand drops the cached values too
+	SyncCounting other(true);
+	other.Level = 0.3;
+	memo.SetChild(0, &other);
+	SYNC_CHECK(memo.GetValue(200) == 0.3f);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,128 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+SyncStaticArena<8192> arena;
+
+// Walks the function tick by tick: the value is constant from t until GetNextChange(t), and once it
+// returns SYNC_NEVER the value does not change anymore, up to the 2^31 ticks operations can tell apart
+static void CheckNextChange(SyncFunction& function, unsigned long last)
+{
+	// Furthest change announced so far, the value can not change before it
+	unsigned long reach = 0;
+	float previous = function.GetValue(0);
+
+	for (unsigned long t = 0; t <= last; t++)
+	{
+		const float value = function.GetValue(t);
+		if (t > 0 && t < reach && value != previous)
+		{
+			printf("type %d, t %lu: changed from %f to %f before %lu\n", static_cast<int>(function.GetType()), t, previous, value, reach);
+			SyncTestFailures++;
+			return;
+		}
+
+		const unsigned long change = function.GetNextChange(t);
+		if (change <= t)
+		{
+			printf("type %d, t %lu: next change at %lu\n", static_cast<int>(function.GetType()), t, change);
+			SyncTestFailures++;
+			return;
+		}
+		if (change > reach) reach = change;
+		previous = value;
+	}
+
+	if (reach != SYNC_NEVER) return;
+	const unsigned long Far[] = { last * 2, last * 10 + 7, 1000000UL, 0x70000000UL };
+	for (unsigned long t : Far)
+	{
+		if (function.GetValue(t) != previous)
+		{
+			printf("type %d: SYNC_NEVER, but changed to %f at %lu\n", static_cast<int>(function.GetType()), function.GetValue(t), t);
+			SyncTestFailures++;
+			return;
+		}
+	}
+}
+
+// Finite functions, walked past their Interval until their value settles
+static void CheckFinite(SyncFunction& function)
+{
+	CheckNextChange(function, function.Interval * 2 + 20);
+	if (function.GetNextChange(function.Interval * 2 + 20) != SYNC_NEVER)
+	{
+		printf("type %d: changes at %lu after its Interval\n", static_cast<int>(function.GetType()), function.GetNextChange(function.Interval * 2 + 20));
+		SyncTestFailures++;
+	}
+}
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+	SyncArena::Use(arena);
+
+	// Functions
+	auto zeros = SyncZeros(120);
+	auto constant = SyncConstant(130, 0.7);
+	auto step = SyncStep(40, 140);
+	auto ramp = SyncRamp(150);
+	auto inverseRamp = SyncInverseRamp(160);
+	auto triangular = SyncTriangular(50, 120);
+	auto trapezium = SyncTrapezium(30, 60, 90);
+	auto sine = SyncSin(200);
+	auto cosine = SyncCos(250, true);
+	SyncFunction* functions[] = { &zeros, &constant, &step, &ramp, &inverseRamp, &triangular, &trapezium, &sine, &cosine };
+	for (SyncFunction* function : functions) CheckFinite(*function);
+
+	// Transformations
+	CheckFinite(step.Speed(2.0));
+	CheckFinite(step.Speed(0.3));
+	CheckFinite(trapezium.Speed(0.7));
+	CheckFinite(step.ScaleY(0.5));
+	CheckFinite(trapezium.OffsetY(0.25));
+	CheckFinite(SyncNew<SyncTransformationAffineY>(step, 0.5, 0.2));
+	CheckFinite(step.SliceX(60));
+	CheckFinite(trapezium.SliceX(-70));
+	CheckFinite(step.Delay(45));
+	CheckFinite(trapezium.Inverse());
+	CheckFinite(step.Reverse());
+	CheckFinite(step.Repeat(3));
+	CheckFinite(trapezium.Mirroring());
+	CheckFinite(step.Memoize());
+
+	// Infinite repetitions never settle
+	auto& forever = step.Repeat();
+	CheckNextChange(forever, 1000);
+	SYNC_CHECK(forever.GetNextChange(1000) != SYNC_NEVER);
+
+	// Operations, with operands started at other times than the operation
+	SyncTestMillis = 25;
+	auto late = SyncTrapezium(30, 60, 30);
+	SyncTestMillis = 60;
+	CheckFinite(SyncNew<SyncAdd>(step, late));
+	CheckFinite(SyncNew<SyncSubstract>(constant, late));
+	CheckFinite(SyncNew<SyncMax>(late, step));
+	CheckFinite(SyncNew<SyncMin>(constant, trapezium));
+	CheckFinite(SyncNew<SyncAnd>(step, late));
+	CheckFinite(SyncNew<SyncOr>(step, late));
+	auto concatenation = step + constant;
+	CheckFinite(concatenation);
+	CheckFinite(SyncAddAll(step, late, trapezium));
+	CheckFinite(SyncSequenceOf(step, zeros, constant, trapezium));
+
+	// Deep graphs
+	auto sequence = step + constant;
+	CheckFinite(sequence.Repeat(3).ScaleY(3.0).OffsetY(0.2).Inverse().Speed(2.0).Mirroring());
+	auto compound = (SyncInline(step) + trapezium + zeros).Repeat(2).SliceX(100).Delay(10);
+	CheckFinite(compound);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
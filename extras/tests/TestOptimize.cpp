@@ -0,0 +1,80 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+SyncStaticArena<2048> arena;
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+	SyncArena::Use(arena);
+
+	// Optimized graphs give the same values
+	auto ramp = SyncRamp(1000);
+	auto& affine = ramp.ScaleY(0.5).OffsetY(0.2).Inverse();
+	SyncOptimizeStats stats;
+	auto& optimized = SyncOptimize(affine, &stats);
+	SYNC_CHECK(optimized.GetType() == SyncNodeType::AffineY);
+	SYNC_CHECK(stats.NodesAfter == 2);
+	SYNC_CHECK_NEAR(optimized.GetValue(300), 1.0 - (0.5 * 0.3 + 0.2), 1e-6);
+
+	// Identities are dropped when the child runs on the same time frame
+	auto& identity = ramp.ScaleY(1.0);
+	SYNC_CHECK(&SyncOptimize(identity) == &ramp);
+	auto& zero = SyncNew<SyncAdd>(ramp, SyncNew<SyncZeros>(1000));
+	SYNC_CHECK(&SyncOptimize(zero) == &ramp);
+
+	// ... and kept when the dropped node started later than its child
+	SyncTestMillis = 500;
+	auto& late = ramp.ScaleY(1.0);
+	SyncTestMillis = 700;
+	const float before = late.GetValue();
+	auto& lateOptimized = SyncOptimize(late);
+	SYNC_CHECK_NEAR(before, 0.2, 1e-6);
+	SYNC_CHECK_NEAR(lateOptimized.GetValue(), before, 1e-6);
+	SyncTestMillis = 500;
+	auto& lateSpeed = ramp.Speed(1.0);
+	SyncTestMillis = 700;
+	SYNC_CHECK_NEAR(SyncOptimize(lateSpeed).GetValue(), 0.2, 1e-6);
+
+	// Speed chains are only fused when the fused node gives the same times
+	SyncTestMillis = 0;
+	auto slow = SyncRamp(1000);
+	auto& whole = slow.Speed(0.5).Speed(10);
+	auto& fraction = slow.Speed(2).Speed(1.5);
+	float wholeValues[400];
+	float fractionValues[400];
+	for (unsigned long t = 0; t < 400; t++)
+	{
+		wholeValues[t] = whole.GetValue(t);
+		fractionValues[t] = fraction.GetValue(t);
+	}
+	const unsigned long wholeInterval = whole.Interval;
+	const unsigned long fractionInterval = fraction.Interval;
+	auto& wholeOptimized = SyncOptimize(whole);
+	auto& fractionOptimized = SyncOptimize(fraction);
+	SYNC_CHECK(SyncCountNodes(wholeOptimized) == 2);
+	SYNC_CHECK(SyncCountNodes(fractionOptimized) == 3);
+	SYNC_CHECK(wholeOptimized.Interval == wholeInterval);
+	SYNC_CHECK(fractionOptimized.Interval == fractionInterval);
+	SYNC_CHECK_NEAR(wholeOptimized.GetValue(31), wholeValues[31], 1e-6);
+	SYNC_CHECK_NEAR(fractionOptimized.GetValue(31), fractionValues[31], 1e-6);
+	for (unsigned long t = 0; t < 400; t++)
+	{
+		if (fabs(wholeOptimized.GetValue(t) - wholeValues[t]) > 1e-6 || fabs(fractionOptimized.GetValue(t) - fractionValues[t]) > 1e-6)
+		{
+			printf("Speed chain differs at %lu\n", t);
+			SyncTestFailures++;
+			break;
+		}
+	}
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,67 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+int main()
+{
+	// The first write sends every channel, in bursts of up to MaxBurst
+	SyncMockDevice<6> device(8, 4);
+	SyncOutput<6> output(device);
+	float values[6] = { 0.0, 0.25, 0.5, 0.75, 1.0, 0.1 };
+	SYNC_CHECK(output.Write(values) == 2);
+	SYNC_CHECK(device.Transactions == 2);
+	SYNC_CHECK(device.ChannelWrites == 6);
+	SYNC_CHECK(device.Codes[0] == 0 && device.Codes[4] == 255);
+	for (uint8_t channel = 0; channel < 6; channel++) SYNC_CHECK(device.Codes[channel] == output.GetCode(channel));
+
+	// Unchanged codes are not written, even if the value changed within the same code
+	values[1] = 0.2502;
+	SYNC_CHECK(output.Write(values) == 0);
+	SYNC_CHECK(device.ChannelWrites == 6);
+	SYNC_CHECK(output.GetSavedChannels() == 6);
+
+	// Changed codes are, consecutive ones in the same transaction
+	values[1] = 0.3;
+	values[2] = 0.6;
+	values[5] = 0.0;
+	SYNC_CHECK(output.Write(values) == 2);
+	SYNC_CHECK(device.ChannelWrites == 9);
+	SYNC_CHECK(device.Codes[1] == output.GetCode(1) && device.Codes[2] == output.GetCode(2) && device.Codes[5] == 0);
+	SYNC_CHECK(device.Codes[1] != 64);
+
+	// Fixed point values give the same codes
+	int32_t valuesQ16[6];
+	for (uint8_t channel = 0; channel < 6; channel++) valuesQ16[channel] = SyncToQ16(values[channel]);
+	SYNC_CHECK(output.WriteQ16(valuesQ16) == 0);
+	valuesQ16[3] = 0;
+	SYNC_CHECK(output.WriteQ16(valuesQ16) == 1);
+	SYNC_CHECK(device.Codes[3] == 0);
+
+	// Invalidate() sends every channel again
+	output.Invalidate();
+	SYNC_CHECK(output.WriteQ16(valuesQ16) == 2);
+
+	// Every channel of every call is either written or saved
+	SYNC_CHECK(output.GetWrittenChannels() == device.ChannelWrites);
+	SYNC_CHECK(output.GetTransactions() == device.Transactions);
+	SYNC_CHECK(output.GetWrittenChannels() + output.GetSavedChannels() == 6 * 6);
+	SYNC_CHECK(output.GetWrittenChannels() == 16);
+
+	// Devices without bursts get one channel per transaction
+	SyncMockDevice<3> single(12, 1);
+	SyncOutput<3> singleOutput(single);
+	const float levels[3] = { 0.5, 0.5, 1.0 };
+	SYNC_CHECK(singleOutput.Write(levels) == 3);
+	SYNC_CHECK(single.Codes[2] == 4095);
+
+	output.ResetStatistics();
+	SYNC_CHECK(output.GetWrittenChannels() == 0 && output.GetSavedChannels() == 0 && output.GetTransactions() == 0);
+
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,116 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+// Patterns encoded by extras/SyncPattern.py, generated by the build when Python is available
+#if SYNC_TEST_HOST_PATTERNS
+#include "SyncTestPatterns.h"
+#endif
+
+SyncStaticArena<2048> arena;
+
+// Encodes the graph, loads it back and evaluates it against the graph. If hostPattern is given, it must
+// have the same bytes as the pattern encoded by the library
+static void CheckRoundTrip(SyncFunction& graph, const uint8_t* hostPattern = nullptr, size_t hostSize = 0)
+{
+	SyncStaticProgram<16> compiled;
+	SYNC_CHECK(compiled.Compile(graph));
+	uint8_t buffer[128];
+	const size_t size = SyncPatternEncode(compiled, buffer, sizeof(buffer));
+	SYNC_CHECK(size > 0);
+	if (hostPattern != nullptr) SYNC_CHECK(hostSize == size && memcmp(hostPattern, buffer, size) == 0);
+
+	SyncStaticProgram<16> program;
+	SyncMemoryReader reader(hostPattern != nullptr ? hostPattern : buffer, hostPattern != nullptr ? hostSize : size);
+	SYNC_CHECK(SyncPatternLoad(reader, program));
+	SYNC_CHECK(program.Interval == graph.Interval);
+	for (unsigned long t = 0; t <= graph.Interval + 100; t += 3) SYNC_CHECK_NEAR(program.GetValue(t), graph.GetValue(t), 1e-5);
+}
+
+// Loads the pattern of the graph with the float parameter original replaced by factor, and a valid checksum
+static bool LoadWithFactor(SyncFunction& graph, float original, float factor)
+{
+	SyncStaticProgram<16> compiled;
+	SYNC_CHECK(compiled.Compile(graph));
+	uint8_t buffer[32];
+	const size_t size = SyncPatternEncode(compiled, buffer, sizeof(buffer));
+
+	SyncParameter found, replaced;
+	found.F = original;
+	replaced.F = factor;
+	for (size_t i = 0; i + 4 < size; i++)
+	{
+		if (memcmp(&buffer[i], &found.U, 4) != 0) continue;
+		memcpy(&buffer[i], &replaced.U, 4);
+		break;
+	}
+	uint8_t checksum = 0;
+	for (size_t i = 0; i + 1 < size; i++) checksum += buffer[i];
+	buffer[size - 1] = checksum;
+
+	SyncStaticProgram<16> program;
+	SyncMemoryReader reader(buffer, size);
+	return SyncPatternLoad(reader, program);
+}
+
+int main()
+{
+	SyncArena::Use(arena);
+
+	auto ramp = SyncRamp(150);
+	auto constant = SyncConstant(300, 1.0);
+	auto zeros = SyncZeros(200);
+	auto rampConstant = ramp + constant;
+	auto sequence = rampConstant + zeros;
+	CheckRoundTrip(sequence.Repeat(3).ScaleY(3.0));
+
+	auto triangular = SyncTriangular(500);
+	CheckRoundTrip(triangular.Repeat());
+
+	auto sine = SyncSin(400, true);
+	auto cosine = SyncCos(300);
+	auto step = SyncStep(100, 250);
+	auto trapezium = SyncTrapezium(100, 50, 150);
+	auto inverseRamp = SyncInverseRamp(200);
+	CheckRoundTrip(SyncNew<SyncMax>(sine.Speed(1.5), cosine.SliceX(-60).Delay(40)));
+	CheckRoundTrip(SyncNew<SyncAnd>(step.Mirroring(), trapezium.Reverse()).Inverse());
+	CheckRoundTrip(SyncNew<SyncTransformationAffineY>(inverseRamp, 0.5, 0.25).OffsetY(0.1).Repeat(2));
+
+	// Corrupted patterns are rejected
+	SyncStaticProgram<16> compiled(triangular.Repeat());
+	uint8_t buffer[32];
+	const size_t size = SyncPatternEncode(compiled, buffer, sizeof(buffer));
+	buffer[5] ^= 0x01;
+	SyncMemoryReader corrupted(buffer, size);
+	SyncStaticProgram<16> program;
+	SYNC_CHECK(!SyncPatternLoad(corrupted, program));
+	SyncMemoryReader truncated(buffer, size - 1);
+	SYNC_CHECK(!SyncPatternLoad(truncated, program));
+
+	// ... and so are non finite floats and Speed factors that are not positive, even with a valid checksum
+	auto& speed = ramp.Speed(2.0);
+	SYNC_CHECK(LoadWithFactor(speed, 2.0, 0.5));
+	SYNC_CHECK(!LoadWithFactor(speed, 2.0, NAN));
+	SYNC_CHECK(!LoadWithFactor(speed, 2.0, INFINITY));
+	SYNC_CHECK(!LoadWithFactor(speed, 2.0, -INFINITY));
+	SYNC_CHECK(!LoadWithFactor(speed, 2.0, 0.0));
+	SYNC_CHECK(!LoadWithFactor(speed, 2.0, -1.0));
+	SYNC_CHECK(LoadWithFactor(ramp.ScaleY(2.0), 2.0, -1.0));
+	SYNC_CHECK(!LoadWithFactor(ramp.ScaleY(2.0), 2.0, NAN));
+
+#if SYNC_TEST_HOST_PATTERNS
+	CheckRoundTrip(sequence.Repeat(3).ScaleY(3.0), compound, sizeof(compound));
+	CheckRoundTrip(triangular.Repeat(), breathe, sizeof(breathe));
+	CheckRoundTrip(SyncNew<SyncMax>(sine.Speed(1.5), cosine.SliceX(-60).Delay(40)), layers, sizeof(layers));
+	CheckRoundTrip(SyncNew<SyncAnd>(step.Mirroring(), trapezium.Reverse()).Inverse(), blink, sizeof(blink));
+	CheckRoundTrip(SyncNew<SyncTransformationAffineY>(inverseRamp, 0.5, 0.25).OffsetY(0.1).Repeat(2), fade, sizeof(fade));
+#endif
+
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,81 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+
+	SyncTestMillis = 0;
+	auto first = SyncRamp(100);
+	auto second = SyncConstant(50, 0.3);
+	auto third = SyncRamp(200);
+	auto fourth = SyncConstant(80, 0.8);
+	SyncPlayer player(first);
+	SYNC_CHECK_NEAR(player.Update(), 0.0, 1e-6);
+
+	// The published graph starts at the next period of the active one
+	player.Publish(second);
+	SYNC_CHECK(player.IsPending());
+	SYNC_CHECK(player.TakeRetired() == nullptr);
+	SyncTestMillis = 50;
+	SYNC_CHECK_NEAR(player.Update(), 0.5, 1e-6);
+	SyncTestMillis = 99;
+	SYNC_CHECK_NEAR(player.Update(), 0.99, 1e-6);
+	SYNC_CHECK(player.IsPending());
+	SyncTestMillis = 100;
+	SYNC_CHECK_NEAR(player.Update(), 0.3, 1e-6);
+	SYNC_CHECK(!player.IsPending());
+	SYNC_CHECK(player.TakeRetired() == &first);
+	SYNC_CHECK(player.TakeRetired() == nullptr);
+
+	// With a crossfade, both graphs are mixed until the fade ends, and the previous one is retired afterwards
+	player.Publish(third, 40);
+	SyncTestMillis = 149;
+	SYNC_CHECK_NEAR(player.Update(), 0.3, 1e-6);
+	SyncTestMillis = 150;
+	SYNC_CHECK_NEAR(player.Update(), 0.3, 1e-6);
+	SYNC_CHECK(player.IsFading());
+	SyncTestMillis = 170;
+	SYNC_CHECK_NEAR(player.Update(), 0.5 * 0.1 + 0.5 * 0.3, 1e-6);
+	SYNC_CHECK(abs(player.UpdateQ16(170) - SyncToQ16(0.5 * 0.1 + 0.5 * 0.3)) <= 2);
+	SYNC_CHECK(player.TakeRetired() == nullptr);
+	SyncTestMillis = 190;
+	SYNC_CHECK_NEAR(player.Update(), 0.2, 1e-6);
+	SYNC_CHECK(!player.IsFading());
+	SYNC_CHECK(player.TakeRetired() == &second);
+
+	// A graph published again before the swap replaces the pending one, and can start at once
+	player.Publish(first, 0, false);
+	player.Publish(fourth, 0, false);
+	SyncTestMillis = 200;
+	SYNC_CHECK_NEAR(player.Update(), 0.8, 1e-6);
+	SYNC_CHECK(player.TakeRetired() == &third);
+	SYNC_CHECK(player.UpdateQ16(230) == SyncToQ16(0.8));
+
+	// A crossfade can also start at once
+	player.Publish(second, 20, false);
+	SyncTestMillis = 205;
+	SYNC_CHECK_NEAR(player.Update(), 0.8, 1e-6);
+	SYNC_CHECK(player.IsFading());
+	SyncTestMillis = 215;
+	SYNC_CHECK_NEAR(player.Update(), 0.5 * 0.3 + 0.5 * 0.8, 1e-6);
+	SYNC_CHECK(player.TakeRetired() == nullptr);
+	SyncTestMillis = 225;
+	SYNC_CHECK_NEAR(player.Update(), 0.3, 1e-6);
+	SYNC_CHECK(player.TakeRetired() == &fourth);
+
+	// Without a graph the output is 0.0
+	SyncPlayer empty;
+	SYNC_CHECK(empty.Update() == 0.0f);
+	SYNC_CHECK(empty.UpdateQ16(0) == 0);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
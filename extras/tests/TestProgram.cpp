@@ -0,0 +1,58 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+SyncStaticArena<2048> arena;
+
+// The program gives the values of the graph it was compiled from, going forward and jumping
+static void CheckProgram(SyncFunction& graph)
+{
+	SyncStaticProgram<16> program;
+	SYNC_CHECK(program.Compile(graph));
+	SYNC_CHECK(program.Interval == graph.Interval);
+	for (unsigned long t = 0; t <= graph.Interval + 100; t += 7) SYNC_CHECK_NEAR(program.GetValue(t), graph.GetValue(t), 1e-5);
+	for (unsigned long t = 0; t <= 20; t++)
+	{
+		const unsigned long jump = (t * 7919UL) % (graph.Interval + 100);
+		SYNC_CHECK_NEAR(program.GetValue(jump), graph.GetValue(jump), 1e-5);
+	}
+}
+
+int main()
+{
+	SyncArena::Use(arena);
+
+	auto ramp = SyncRamp(150);
+	auto ramp256 = SyncRamp(256);
+	auto sine = SyncSin(250, true);
+	CheckProgram(ramp.Repeat(3));
+	CheckProgram(ramp256.Repeat(4));
+	CheckProgram(ramp.Repeat());
+	auto sequence = ramp + sine;
+	CheckProgram(sequence.Repeat(2).ScaleY(0.5).Mirroring());
+	CheckProgram(ramp.SliceX(-50).Repeat(2));
+
+	// Offsets set after the construction are used by the node and by the programs compiled from it
+	auto& slice = ramp.SliceX(20);
+	slice.SetOffset(-50);
+	SYNC_CHECK(slice.GetOffset() == -50);
+	SYNC_CHECK(slice.GetValue(0) == ramp.GetValue(100));
+	CheckProgram(slice);
+
+	// Repetitions of an empty function do not divide by zero, and can not be compiled
+	auto empty = SyncZeros(0);
+	auto& repeatEmpty = empty.Repeat(3);
+	SYNC_CHECK(repeatEmpty.GetValue(10) == 0.0f);
+	SYNC_CHECK(empty.Repeat().GetValue(10) == 0.0f);
+	SyncStaticProgram<8> program(repeatEmpty);
+	SYNC_CHECK(program.GetSize() == 0);
+	SYNC_CHECK(program.GetValue(10) == 0.0f);
+
+	return SYNC_TEST_RESULT();
+}
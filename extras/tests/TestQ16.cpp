@@ -0,0 +1,106 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+SyncStaticArena<4096> arena;
+
+// GetValueQ16() stays within 1 LSB of the fixed point conversion of GetValue(), before and after the Interval
+// Sums truncate each operand, so they may add 1 LSB per operand
+static void CheckQ16(SyncFunction& function, int32_t tolerance = 1)
+{
+	const unsigned long last = function.Interval + function.Interval / 4 + 2;
+	const unsigned long step = last / 2000 + 1;
+
+	for (unsigned long t = 0; t <= last; t += step)
+	{
+		const int32_t fixed = function.GetValueQ16(t);
+		const int32_t converted = SyncToQ16(function.GetValue(t));
+		if (abs(fixed - converted) > tolerance)
+		{
+			printf("type %d, t %lu: %ld in Q16, %ld from float\n", static_cast<int>(function.GetType()), t,
+				static_cast<long>(fixed), static_cast<long>(converted));
+			SyncTestFailures++;
+			return;
+		}
+	}
+}
+
+// SyncMulQ16 gives the same result as the 64 bits product
+static void CheckMulQ16(int32_t a, int32_t b)
+{
+	const int32_t expected = static_cast<int32_t>((static_cast<int64_t>(a) * b) >> 16);
+	if (SyncMulQ16(a, b) != expected)
+	{
+		printf("SyncMulQ16(%ld, %ld): %ld instead of %ld\n", static_cast<long>(a), static_cast<long>(b),
+			static_cast<long>(SyncMulQ16(a, b)), static_cast<long>(expected));
+		SyncTestFailures++;
+	}
+}
+
+int main()
+{
+	const int32_t Edges[] = { 0, 1, -1, 0xFFFF, 0x10000, -0x10000, 0x12345, -0x54321, 0x7FFFFFFF, -0x7FFFFFFF - 1 };
+	for (int32_t a : Edges)
+		for (int32_t b : Edges) CheckMulQ16(a, b);
+	uint32_t random = 12345;
+	for (int i = 0; i < 100000; i++)
+	{
+		random = random * 1664525UL + 1013904223UL;
+		const int32_t a = static_cast<int32_t>(random);
+		random = random * 1664525UL + 1013904223UL;
+		CheckMulQ16(a, static_cast<int32_t>(random) >> (i % 24));
+	}
+
+	SyncClock::SetSource(SyncTestClock);
+	SyncArena::Use(arena);
+
+	// Functions, sin and cos with the table kernel, which GetValueQ16 always uses
+	auto zeros = SyncZeros(120);
+	auto constant = SyncConstant(130, 0.7);
+	auto step = SyncStep(40, 140);
+	auto ramp = SyncRamp(1500);
+	auto inverseRamp = SyncInverseRamp(777);
+	auto triangular = SyncTriangular(500, 1200);
+	auto trapezium = SyncTrapezium(300, 600, 900);
+	auto sine = SyncSin(2000, true);
+	auto cosine = SyncCos(2500, true);
+	SyncFunction* functions[] = { &zeros, &constant, &step, &ramp, &inverseRamp, &triangular, &trapezium, &sine, &cosine };
+	for (SyncFunction* function : functions) CheckQ16(*function);
+
+	// Transformations
+	CheckQ16(ramp.Speed(2.0));
+	CheckQ16(ramp.Speed(0.3));
+	CheckQ16(sine.ScaleY(0.37));
+	CheckQ16(sine.OffsetY(0.25));
+	CheckQ16(SyncNew<SyncTransformationAffineY>(triangular, -0.5, 0.7));
+	CheckQ16(ramp.SliceX(400));
+	CheckQ16(ramp.SliceX(-700));
+	CheckQ16(ramp.Delay(45));
+	CheckQ16(trapezium.Inverse());
+	CheckQ16(ramp.Reverse());
+	CheckQ16(ramp.Repeat(3));
+	CheckQ16(step.Repeat());
+	CheckQ16(triangular.Mirroring());
+	CheckQ16(ramp.Memoize());
+
+	// Operations
+	CheckQ16(SyncNew<SyncAdd>(ramp, triangular));
+	CheckQ16(SyncNew<SyncSubstract>(sine, triangular));
+	CheckQ16(SyncNew<SyncMax>(triangular, cosine));
+	CheckQ16(SyncNew<SyncMin>(ramp, cosine));
+	CheckQ16(SyncNew<SyncAnd>(step, triangular));
+	CheckQ16(SyncNew<SyncOr>(step, triangular));
+	auto concatenation = ramp + sine;
+	CheckQ16(concatenation);
+	CheckQ16(SyncAddAll(ramp, triangular, sine), 2);
+	CheckQ16(SyncSequenceOf(ramp, step, sine, triangular));
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,105 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+SyncStaticArena<8192> arena;
+
+// Render() gives the same samples as GetValue(), for several starts and steps, including the
+// ones past the Interval of the function
+static void CheckRender(SyncFunction& function)
+{
+	static const unsigned long Starts[] = { 0, 1, 37, 149, 150, 500 };
+	static const unsigned long Steps[] = { 1, 3, 10, 64, 151 };
+	const size_t Samples = 200;
+	float block[Samples];
+
+	for (unsigned long start : Starts)
+	{
+		for (unsigned long step : Steps)
+		{
+			function.Render(block, Samples, start, step);
+			for (size_t i = 0; i < Samples; i++)
+			{
+				const float value = function.GetValue(start + i * step);
+				if (fabs(block[i] - value) > 1e-5)
+				{
+					printf("type %d, start %lu, step %lu, sample %u: %f rendered, %f evaluated\n", static_cast<int>(function.GetType()),
+						start, step, static_cast<unsigned>(i), block[i], value);
+					SyncTestFailures++;
+					return;
+				}
+			}
+		}
+	}
+}
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+	SyncArena::Use(arena);
+
+	// Functions
+	auto zeros = SyncZeros(120);
+	auto constant = SyncConstant(130, 0.7);
+	auto step = SyncStep(40, 140);
+	auto ramp = SyncRamp(150);
+	auto inverseRamp = SyncInverseRamp(160);
+	auto triangular = SyncTriangular(50, 120);
+	auto trapezium = SyncTrapezium(30, 60, 90);
+	auto sine = SyncSin(200);
+	auto fastSine = SyncSin(200, true);
+	auto cosine = SyncCos(250);
+	auto fastCosine = SyncCos(250, true);
+	auto easing = SyncEasing(180, SyncCurve(SyncCurveType::CubicInOut));
+	SyncFunction* functions[] = { &zeros, &constant, &step, &ramp, &inverseRamp, &triangular, &trapezium,
+		&sine, &fastSine, &cosine, &fastCosine, &easing };
+	for (SyncFunction* function : functions) CheckRender(*function);
+
+	// Transformations
+	CheckRender(ramp.Speed(2.0));
+	CheckRender(ramp.Speed(0.3));
+	CheckRender(sine.ScaleY(0.5));
+	CheckRender(sine.OffsetY(0.25));
+	CheckRender(SyncNew<SyncTransformationAffineY>(triangular, 0.5, 0.2));
+	CheckRender(ramp.SliceX(40));
+	CheckRender(ramp.SliceX(-70));
+	CheckRender(ramp.Delay(45));
+	CheckRender(trapezium.Inverse());
+	CheckRender(ramp.Reverse());
+	CheckRender(ramp.Repeat(3));
+	CheckRender(step.Repeat());
+	CheckRender(triangular.Mirroring());
+	CheckRender(ramp.Curve(SyncCurve(SyncCurveType::Gamma, 2.2)));
+	CheckRender(ramp.Memoize());
+	CheckRender(SyncNew<SyncRoot>(sine.Repeat()));
+
+	// Operations, with operands started at other times than the operation
+	SyncTestMillis = 25;
+	auto late = SyncTriangular(80, 80);
+	SyncTestMillis = 60;
+	CheckRender(SyncNew<SyncAdd>(ramp, late));
+	CheckRender(SyncNew<SyncSubstract>(sine, late));
+	CheckRender(SyncNew<SyncMax>(late, cosine));
+	CheckRender(SyncNew<SyncMin>(ramp, cosine));
+	CheckRender(SyncNew<SyncAnd>(step, late));
+	CheckRender(SyncNew<SyncOr>(step, late));
+	auto concatenation = ramp + sine;
+	CheckRender(concatenation);
+	CheckRender(SyncAddAll(ramp, late, sine));
+	CheckRender(SyncSequenceOf(ramp, step, sine, triangular));
+
+	// Deep graphs
+	auto sequence = ramp + constant;
+	CheckRender(sequence.Repeat(3).ScaleY(3.0).OffsetY(0.2).Inverse().Speed(2.0).Mirroring().Repeat());
+	auto compound = (SyncInline(ramp) + trapezium + zeros).Repeat(2).SliceX(100).Delay(10);
+	CheckRender(compound);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+SyncStaticArena<16384> arena;
+
+// The N-ary node gives the same values as the chain of binary nodes, at every tick, including the
+// boundaries between operands
+static void CheckSame(const char* name, SyncFunction& node, SyncFunction& chain)
+{
+	if (node.Interval != chain.Interval)
+	{
+		printf("%s: Interval %lu, chain %lu\n", name, static_cast<unsigned long>(node.Interval), static_cast<unsigned long>(chain.Interval));
+		SyncTestFailures++;
+		return;
+	}
+
+	for (unsigned long t = 0; t <= node.Interval + 20; t++)
+	{
+		if (node.GetValue(t) != chain.GetValue(t) || node.GetValueQ16(t) != chain.GetValueQ16(t) || node.IsFinished(t) != chain.IsFinished(t))
+		{
+			printf("%s, t %lu: %f, chain %f\n", name, t, node.GetValue(t), chain.GetValue(t));
+			SyncTestFailures++;
+			return;
+		}
+	}
+}
+
+// Sequence of the operands against a chain of operator +
+template<typename... Ops>
+static void CheckSequence(Ops&... ops)
+{
+	SyncFunction* list[] = { &ops... };
+	SyncFunction* chain = list[0];
+	for (uint8_t i = 1; i < sizeof...(Ops); i++) chain = &SyncNew<SyncConcatenate>(*chain, *list[i]);
+
+	char name[16];
+	snprintf(name, sizeof(name), "Sequence<%u>", static_cast<unsigned>(sizeof...(Ops)));
+	CheckSame(name, SyncSequenceOf(ops...), *chain);
+}
+
+// Each N-ary operation against a chain of the binary one
+template<typename TBinary, typename TNary>
+static void CheckCombine(const char* name, TNary& node)
+{
+	SyncFunction* chain = node.GetChild(0);
+	for (uint8_t i = 1; i < node.GetChildCount(); i++) chain = &SyncNew<TBinary>(*chain, *node.GetChild(i));
+	CheckSame(name, node, *chain);
+}
+
+template<typename... Ops>
+static void CheckCombines(Ops&... ops)
+{
+	CheckCombine<SyncAdd>("AddN", SyncAddAll(ops...));
+	CheckCombine<SyncMax>("MaxN", SyncMaxAll(ops...));
+	CheckCombine<SyncMin>("MinN", SyncMinAll(ops...));
+	CheckCombine<SyncAnd>("AndN", SyncAndAll(ops...));
+	CheckCombine<SyncOr>("OrN", SyncOrAll(ops...));
+}
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+	SyncArena::Use(arena);
+
+	// Short and uneven intervals, so every boundary is close to the others
+	auto a = SyncRamp(7);
+	auto b = SyncStep(3, 5);
+	auto c = SyncTriangular(4, 6);
+	auto d = SyncInverseRamp(1);
+	auto e = SyncRamp(13);
+	auto f = SyncConstant(2, 0.4);
+	auto g = SyncTrapezium(2, 3, 4);
+	auto h = SyncSin(9, true);
+
+	CheckSequence(a, b);
+	CheckSequence(a, b, c);
+	CheckSequence(d, a, b, c);
+	CheckSequence(a, b, c, d, e);
+	CheckSequence(f, a, d, b, c, e);
+	CheckSequence(a, b, c, d, e, f, g);
+	CheckSequence(h, a, b, c, d, e, f, g);
+	CheckSequence(d, d, d, a, d);
+
+	CheckCombines(a, b);
+	CheckCombines(a, b, c);
+	CheckCombines(a, b, c, d, e, f, g, h);
+
+	// Operands started before the operation
+	SyncTestMillis = 4;
+	auto late = SyncTriangular(10, 10);
+	SyncTestMillis = 10;
+	auto later = SyncRamp(12);
+	CheckCombines(late, a, later, g);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
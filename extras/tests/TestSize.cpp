@@ -0,0 +1,98 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+// Built with SYNC_COMPACT_NODES and SYNC_SHORT_INTERVALS. SYNC_DEFAULT_SIZEOF_<class> are the sizes of
+// the default nodes, measured by the build
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+// Every compact node is smaller than the default one
+#define SYNC_CHECK_SMALLER(T) \
+	static_assert(sizeof(T) < SYNC_DEFAULT_SIZEOF_##T, #T " is not smaller with compact nodes")
+
+// The bytes the node layout owns, beyond the vtable and the operand pointers (which take 2 bytes on an
+// ATmega328, but 8 on the host), are reduced at least 40%
+#define SYNC_CHECK_REDUCED(T, pointers) \
+	static_assert((sizeof(T) - pointers * sizeof(void*)) * 10 <= (SYNC_DEFAULT_SIZEOF_##T - pointers * sizeof(void*)) * 6, \
+		#T " is not reduced by 40% with compact nodes")
+
+SYNC_CHECK_SMALLER(SyncZeros);
+SYNC_CHECK_SMALLER(SyncConstant);
+SYNC_CHECK_SMALLER(SyncStep);
+SYNC_CHECK_SMALLER(SyncRamp);
+SYNC_CHECK_SMALLER(SyncTriangular);
+SYNC_CHECK_SMALLER(SyncTrapezium);
+SYNC_CHECK_SMALLER(SyncSin);
+SYNC_CHECK_SMALLER(SyncCos);
+SYNC_CHECK_SMALLER(SyncTransformationSpeed);
+SYNC_CHECK_SMALLER(SyncTransformationScaleY);
+SYNC_CHECK_SMALLER(SyncTransformationOffsetY);
+SYNC_CHECK_SMALLER(SyncTransformationAffineY);
+SYNC_CHECK_SMALLER(SyncTransformationSliceX);
+SYNC_CHECK_SMALLER(SyncTransformationDelay);
+SYNC_CHECK_SMALLER(SyncTransformationInverse);
+SYNC_CHECK_SMALLER(SyncTransformationReverse);
+SYNC_CHECK_SMALLER(SyncRepeatN);
+SYNC_CHECK_SMALLER(SyncRepeatInfinite);
+SYNC_CHECK_SMALLER(SyncMirroring);
+SYNC_CHECK_SMALLER(SyncRoot);
+SYNC_CHECK_SMALLER(SyncAdd);
+SYNC_CHECK_SMALLER(SyncMax);
+SYNC_CHECK_SMALLER(SyncConcatenate);
+
+// Functions, and the nodes without state of their own. Speed, the repetitions and SyncRoot keep 32 bits
+// time state (start times, periods and the fraction of the factor) in both layouts
+SYNC_CHECK_REDUCED(SyncZeros, 1);
+SYNC_CHECK_REDUCED(SyncConstant, 1);
+SYNC_CHECK_REDUCED(SyncStep, 1);
+SYNC_CHECK_REDUCED(SyncRamp, 1);
+SYNC_CHECK_REDUCED(SyncTriangular, 1);
+SYNC_CHECK_REDUCED(SyncTrapezium, 1);
+SYNC_CHECK_REDUCED(SyncSin, 1);
+SYNC_CHECK_REDUCED(SyncCos, 1);
+SYNC_CHECK_REDUCED(SyncTransformationScaleY, 2);
+SYNC_CHECK_REDUCED(SyncTransformationOffsetY, 2);
+SYNC_CHECK_REDUCED(SyncTransformationSliceX, 2);
+SYNC_CHECK_REDUCED(SyncTransformationDelay, 2);
+SYNC_CHECK_REDUCED(SyncTransformationInverse, 2);
+SYNC_CHECK_REDUCED(SyncTransformationReverse, 2);
+SYNC_CHECK_REDUCED(SyncMirroring, 2);
+SYNC_CHECK_REDUCED(SyncAdd, 3);
+SYNC_CHECK_REDUCED(SyncMax, 3);
+SYNC_CHECK_REDUCED(SyncConcatenate, 3);
+
+SyncStaticArena<1024> arena;
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+	SyncArena::Use(arena);
+
+	// Compact graphs run on the time of their root
+	SyncTestMillis = 1000;
+	auto ramp = SyncRamp(150);
+	auto constant = SyncConstant(300, 1.0);
+	auto sequence = ramp + constant;
+	SyncRoot root(sequence.Repeat(2).ScaleY(0.5));
+	root.Restart();
+	SyncTestMillis = 1075;
+	SYNC_CHECK_NEAR(root.GetValue(), 0.25, 1e-6);
+	SyncTestMillis = 1000 + 450 + 75;
+	SYNC_CHECK_NEAR(root.GetValue(), 0.25, 1e-6);
+	SyncTestMillis = 1000 + 450 + 200;
+	SYNC_CHECK_NEAR(root.GetValue(), 0.5, 1e-6);
+
+	// Sizes of the graph, for the record
+	printf("Ramp %u -> %u bytes, ScaleY %u -> %u, Add %u -> %u\n",
+		static_cast<unsigned>(SYNC_DEFAULT_SIZEOF_SyncRamp), static_cast<unsigned>(sizeof(SyncRamp)),
+		static_cast<unsigned>(SYNC_DEFAULT_SIZEOF_SyncTransformationScaleY), static_cast<unsigned>(sizeof(SyncTransformationScaleY)),
+		static_cast<unsigned>(SYNC_DEFAULT_SIZEOF_SyncAdd), static_cast<unsigned>(sizeof(SyncAdd)));
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,100 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+using namespace SyncStatic;
+
+SyncStaticArena<4096> arena;
+
+// A compile time pattern has the Interval and the values of the runtime graph it stands for
+template<typename TPattern>
+static void CheckStatic(const char* name, SyncFunction& runtime)
+{
+	if (TPattern::Interval != runtime.Interval)
+	{
+		printf("%s: Interval %lu, runtime %lu\n", name, static_cast<unsigned long>(TPattern::Interval), static_cast<unsigned long>(runtime.Interval));
+		SyncTestFailures++;
+		return;
+	}
+
+	const unsigned long last = runtime.Interval * 2 + 3;
+	for (unsigned long t = 0; t <= last; t++)
+	{
+		const float value = TPattern::Calculate(t);
+		const float expected = runtime.GetValue(t);
+		if (fabs(value - expected) > 1e-5)
+		{
+			printf("%s, t %lu: %f, runtime %f\n", name, t, value, expected);
+			SyncTestFailures++;
+			return;
+		}
+	}
+}
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+	SyncArena::Use(arena);
+
+	// Functions
+	auto zeros = SyncZeros(120);
+	auto constant = SyncConstant(130, 0.25);
+	auto high = SyncConstant(130, 3.0);
+	auto low = SyncConstant(130, -1.0);
+	auto step = SyncStep(40, 140);
+	auto ramp = SyncRamp(150);
+	auto inverseRamp = SyncInverseRamp(160);
+	auto triangular = SyncTriangular(50, 120);
+	auto trapezium = SyncTrapezium(30, 60, 90);
+	auto sine = SyncSin(200, true);
+	auto cosine = SyncCos(250, true);
+	CheckStatic<Zeros<120>>("Zeros", zeros);
+	CheckStatic<Constant<130, 1, 4>>("Constant", constant);
+	CheckStatic<Constant<130, 3>>("Constant (over 1)", high);
+	CheckStatic<Constant<130, -1>>("Constant (under 0)", low);
+	CheckStatic<Step<40, 140>>("Step", step);
+	CheckStatic<Ramp<150>>("Ramp", ramp);
+	CheckStatic<InverseRamp<160>>("InverseRamp", inverseRamp);
+	CheckStatic<Triangular<50, 120>>("Triangular", triangular);
+	CheckStatic<Trapezium<30, 60, 90>>("Trapezium", trapezium);
+	CheckStatic<Sin<200>>("Sin", sine);
+	CheckStatic<Cos<250>>("Cos", cosine);
+
+	// Transformations
+	CheckStatic<Speed<Ramp<150>, 2>>("Speed", ramp.Speed(2.0));
+	CheckStatic<Speed<Ramp<150>, 3, 4>>("Speed (fraction)", ramp.Speed(0.75));
+	CheckStatic<ScaleY<Sin<200>, 1, 2>>("ScaleY", sine.ScaleY(0.5));
+	CheckStatic<OffsetY<Sin<200>, 1, 4>>("OffsetY", sine.OffsetY(0.25));
+	CheckStatic<SliceX<Ramp<150>, 40>>("SliceX", ramp.SliceX(40));
+	CheckStatic<SliceX<Ramp<150>, -70>>("SliceX (negative)", ramp.SliceX(-70));
+	CheckStatic<Delay<Ramp<150>, 45>>("Delay", ramp.Delay(45));
+	CheckStatic<Inverse<Trapezium<30, 60, 90>>>("Inverse", trapezium.Inverse());
+	CheckStatic<Reverse<Ramp<150>>>("Reverse", ramp.Reverse());
+	CheckStatic<Repeat<Ramp<150>, 3>>("RepeatN", ramp.Repeat(3));
+	CheckStatic<Repeat<Step<40, 140>>>("RepeatInfinite", step.Repeat());
+	CheckStatic<Mirroring<Triangular<50, 120>>>("Mirroring", triangular.Mirroring());
+
+	// Operations
+	CheckStatic<Concat<Ramp<150>, Constant<130, 1, 4>, Zeros<120>>>("Concat", SyncSequenceOf(ramp, constant, zeros));
+	CheckStatic<Add<Ramp<150>, Triangular<50, 120>>>("Add", SyncNew<SyncAdd>(ramp, triangular));
+	CheckStatic<Substract<Sin<200>, Triangular<50, 120>>>("Substract", SyncNew<SyncSubstract>(sine, triangular));
+	CheckStatic<Max<Triangular<50, 120>, Cos<250>>>("Max", SyncNew<SyncMax>(triangular, cosine));
+	CheckStatic<Min<Ramp<150>, Cos<250>>>("Min", SyncNew<SyncMin>(ramp, cosine));
+
+	// The compound pattern of the README
+	auto ramp150 = SyncRamp(150);
+	auto constant300 = SyncConstant(300, 1.0);
+	auto zeros200 = SyncZeros(200);
+	auto rampConstant = ramp150 + constant300;
+	auto sequence = rampConstant + zeros200;
+	CheckStatic<ScaleY<Repeat<Concat<Ramp<150>, Constant<300, 1>, Zeros<200>>, 3>, 3>>("Compound", sequence.Repeat(3).ScaleY(3.0));
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,58 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+
+	char buffer[256];
+	SyncBufferPrint out(buffer, sizeof(buffer));
+	auto ramp = SyncRamp(100);
+
+	// One sample per tick instead of looping forever on a period of 0
+	SyncTelemetry<1, 8> telemetry(out, 0, 8, 4);
+	SYNC_CHECK(telemetry.Period == 1);
+	telemetry.Attach(0, ramp);
+	SYNC_CHECK(telemetry.Sample(0) == 1);
+	SYNC_CHECK(telemetry.Sample(3) == 3);
+	SYNC_CHECK(telemetry.Send());
+	SYNC_CHECK(buffer[0] == 'S' && buffer[1] == 'T');
+
+	// Samples that do not fit in the ring are counted, without evaluating them
+	SYNC_CHECK(telemetry.Sample(20) == 7);
+	SYNC_CHECK(telemetry.GetDroppedSamples() == 10);
+	telemetry.ResetStatistics();
+	SYNC_CHECK(telemetry.GetDroppedSamples() == 0);
+
+	// The interrupts are left as they were, also when they were disabled (e.g. in an ISR)
+	SYNC_CHECK((SREG & 0x80) != 0);
+	noInterrupts();
+	telemetry.GetDroppedSamples();
+	telemetry.ResetStatistics();
+	SYNC_CHECK((SREG & 0x80) == 0);
+	interrupts();
+	telemetry.GetDroppedSamples();
+	SYNC_CHECK((SREG & 0x80) != 0);
+
+	// Samples keep their period across the 32 bits wraparound of the clock, whatever the size of unsigned long
+	SyncTelemetry<1, 8> wrapping(out, 10, 8, 4);
+	wrapping.Attach(0, ramp);
+	SYNC_CHECK(wrapping.Sample(0xFFFFFFF0UL) == 1);
+	SYNC_CHECK(wrapping.Sample(0xFFFFFFFFUL) == 1);
+	SYNC_CHECK(wrapping.Sample(15) == 2);
+	SYNC_CHECK(wrapping.Sample(15) == 0);
+	SYNC_CHECK(wrapping.GetDroppedSamples() == 0);
+	out.Clear();
+	SYNC_CHECK(wrapping.Send());
+	SYNC_CHECK(buffer[6] == 4);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
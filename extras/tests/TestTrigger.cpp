@@ -0,0 +1,89 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+
+	// Operations restart with their operands, which run on their own StarTime
+	SyncTestMillis = 0;
+	auto ramp = SyncRamp(100);
+	auto glow = SyncInline(SyncInverseRamp(1000)).ScaleY(0.3);
+	SyncMax flash(ramp, glow);
+	SyncAdd sum(ramp, glow);
+
+	SyncTestMillis = 5000;
+	SyncTriggerQueue<4> queue;
+	SYNC_CHECK(queue.Post(0, SyncTriggerAction::Trigger, 4950));
+	SYNC_CHECK(queue.Post(1, SyncTriggerAction::Restart, 4900));
+
+	SyncTriggerEvent event;
+	SYNC_CHECK(queue.Take(event));
+	SyncApplyTrigger(flash, event);
+	SYNC_CHECK_NEAR(flash.GetValue(), 0.5, 1e-6);
+	SYNC_CHECK(queue.Take(event));
+	SyncApplyTrigger(sum, event);
+	SYNC_CHECK_NEAR(sum.GetValue(), 1.0 + 0.3 * 0.9, 1e-6);
+	SYNC_CHECK(ramp.GetElapsed() == 100);
+
+	// Stop leaves the graph as it was
+	event.Action = SyncTriggerAction::Stop;
+	event.Time = 5000;
+	SyncApplyTrigger(sum, event);
+	SYNC_CHECK(ramp.GetElapsed() == 100);
+
+	// Channels apply the events of a queue to their graphs
+	SyncChannelSet<2> channels(10);
+	channels.Attach(0, flash);
+	channels.Attach(1, sum);
+	SYNC_CHECK(queue.Post(0, SyncTriggerAction::Trigger, 5000));
+	SyncTestMillis = 5025;
+	channels.Update(queue);
+	SYNC_CHECK_NEAR(channels.Values[0], 0.3 * (1.0 - 0.025), 1e-6);
+
+	// Finished channels keep the value of their function, and are not evaluated again
+	SyncTestMillis = 0;
+	auto level = SyncConstant(100, 0.6);
+	SyncChannelSet<1> levels(10);
+	levels.Attach(0, level);
+	SYNC_CHECK(levels.Update());
+	SyncTestMillis = 150;
+	SYNC_CHECK(levels.Update());
+	SYNC_CHECK_NEAR(levels.Values[0], 0.6, 1e-6);
+	SYNC_CHECK(levels.GetEvaluatedChannels() == 1);
+	SyncTestMillis = 160;
+	SYNC_CHECK(levels.Update());
+	SYNC_CHECK_NEAR(levels.Values[0], 0.6, 1e-6);
+	SYNC_CHECK(levels.GetEvaluatedChannels() == 0);
+
+	// Ticks keep their schedule when Update() is late, and skip the missed ones after a long stall
+	SyncTestMillis = 1000;
+	SyncChannelSet<1> ticks(10);
+	SYNC_CHECK(ticks.Update());
+	SyncTestMillis = 1013;
+	SYNC_CHECK(ticks.Update());
+	SyncTestMillis = 1019;
+	SYNC_CHECK(!ticks.Update());
+	SyncTestMillis = 1020;
+	SYNC_CHECK(ticks.Update());
+	SyncTestMillis = 1045;
+	SYNC_CHECK(ticks.Update());
+	SYNC_CHECK(ticks.Update());
+	SYNC_CHECK(!ticks.Update());
+	SyncTestMillis = 1503;
+	SYNC_CHECK(ticks.Update());
+	SYNC_CHECK(!ticks.Update());
+	SyncTestMillis = 1510;
+	SYNC_CHECK(ticks.Update());
+	SYNC_CHECK(ticks.GetTicks() == 7);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
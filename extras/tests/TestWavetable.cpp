@@ -0,0 +1,67 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncWaveforms.h"
+#include "SyncTest.h"
+
+// A baked function is played back within the quantization of the samples, plus the rounding
+// of the sample times (half a tick) when the samples are not a whole number of ticks apart
+template<typename T>
+static void CheckBake(SyncFunction& source, size_t size, float tolerance)
+{
+	T table[256];
+	SyncWavetable<T> wavetable(source, table, size);
+	const bool whole = source.Interval % (size - 1) == 0;
+	const float bound = tolerance + (whole ? 0.0f : 0.5f / source.Interval) + 1e-6f;
+
+	for (unsigned long t = 0; t <= source.Interval; t++)
+	{
+		const float error = fabs(wavetable.GetValue(t) - source.GetValue(t));
+		const float errorQ16 = fabs(SyncQ16ToFloat(wavetable.GetValueQ16(t)) - source.GetValue(t));
+		if (error > bound || errorQ16 > bound + 2.0f / SYNC_Q16_ONE)
+		{
+			printf("%u bytes samples, %u samples, t %lu: errors %g %g over %g\n", static_cast<unsigned>(sizeof(T)),
+				static_cast<unsigned>(size), t, error, errorQ16, bound);
+			SyncTestFailures++;
+			return;
+		}
+	}
+	SYNC_CHECK(wavetable.GetValue(source.Interval + 1) == 0.0f);
+}
+
+int main()
+{
+	SyncClock::SetSource(SyncTestClock);
+
+	auto ramp = SyncRamp(630);
+	auto longRamp = SyncRamp(1000);
+	CheckBake<uint8_t>(ramp, 64, 0.5f / 255);
+	CheckBake<uint16_t>(ramp, 64, 0.5f / 65535);
+	CheckBake<float>(ramp, 64, 0.0f);
+	CheckBake<uint8_t>(longRamp, 64, 0.5f / 255);
+	CheckBake<uint16_t>(longRamp, 256, 0.5f / 65535);
+	CheckBake<float>(longRamp, 17, 0.0f);
+
+	// The scaled samples keep the range of the source
+	auto scaled = SyncInline(SyncRamp(630)).ScaleY(2.0).OffsetY(-0.5);
+	CheckBake<uint8_t>(scaled, 64, 0.5f * 2 / 255);
+	CheckBake<uint16_t>(scaled, 64, 0.5f * 2 / 65535);
+
+	// Empty tables output 0.0
+	uint8_t none[1];
+	SyncWavetable<uint8_t> empty(ramp, none, 0);
+	SYNC_CHECK(empty.GetValue(100) == 0.0f);
+	SYNC_CHECK(empty.GetValueQ16(100) == 0);
+	SyncWavetable<uint16_t> emptyTable(nullptr, 0, 500);
+	SYNC_CHECK(emptyTable.GetValue(100) == 0.0f);
+	float block[4];
+	emptyTable.Render(block, 4, 0, 100);
+	SYNC_CHECK(block[0] == 0.0f && block[3] == 0.0f);
+
+	SyncClock::SetSource(millis);
+	return SYNC_TEST_RESULT();
+}
@@ -0,0 +1,20 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncArena.h"
+
+SyncArena* SyncArena::Current = nullptr;
+SyncArena::Handler SyncArena::OverflowHandler = nullptr;
+
+void SyncArenaOverflow(size_t size)
+{
+	if (SyncArena::OverflowHandler != nullptr) SyncArena::OverflowHandler(*SyncArena::Current, size);
+
+	// A pattern with missing nodes can not be played. The loop has a side effect, an empty one
+	// could be removed by the compiler and return from a [[noreturn]] function
+	for (;;) { delay(1000); }
+}
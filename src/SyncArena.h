@@ -0,0 +1,131 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCARENA_h
+#define _SYNCARENA_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include <new>
+
+// std::forward where the standard library is available (it is not on AVR)
+#if defined(__has_include)
+#if __has_include(<utility>)
+#include <utility>
+#define SYNC_FORWARD(T, value) std::forward<T>(value)
+#endif
+#endif
+#ifndef SYNC_FORWARD
+#define SYNC_FORWARD(T, value) static_cast<T&&>(value)
+#endif
+
+// With 1, nodes that do not fit in the current arena are created in the heap (and counted in Overflows)
+// With 0 (default) a full arena is an error, reported to SyncArena::OverflowHandler
+#ifndef SYNC_ARENA_HEAP_FALLBACK
+#define SYNC_ARENA_HEAP_FALLBACK 0
+#endif
+
+// Fixed capacity bump allocator for the nodes created by the fluent builder
+// Nodes are never destroyed one by one, Reset() releases all of them at once
+class SyncArena
+{
+public:
+	SyncArena(void* buffer, size_t capacity) : _buffer(static_cast<uint8_t*>(buffer)), _capacity(capacity) {}
+
+	void* Allocate(size_t size)
+	{
+		const size_t offset = (_used + Alignment - 1) & ~(Alignment - 1);
+		if (offset + size > _capacity)
+		{
+			Overflows++;
+			return nullptr;
+		}
+
+		_used = offset + size;
+		Allocations++;
+		if (_used > _highWaterMark) _highWaterMark = _used;
+		return _buffer + offset;
+	}
+
+	// Every node placed in the arena becomes invalid
+	void Reset()
+	{
+		_used = 0;
+		Allocations = 0;
+		Overflows = 0;
+	}
+
+	size_t GetCapacity() const { return _capacity; }
+	size_t GetUsed() const { return _used; }
+	size_t GetHighWaterMark() const { return _highWaterMark; }
+
+	// Nodes placed since the last Reset()
+	unsigned int Allocations = 0;
+
+	// Allocations that did not fit since the last Reset()
+	unsigned int Overflows = 0;
+
+	// Called by SyncNew when the current arena is full and there is no heap fallback. It must not return
+	// (e.g. report and reset the board), by default it halts. Use SyncTryNew to handle a full arena instead
+	typedef void (*Handler)(SyncArena& arena, size_t size);
+	static Handler OverflowHandler;
+
+	// Arena used by the fluent builder, nullptr to allocate in the heap
+	static SyncArena* Current;
+
+	static void Use(SyncArena& arena) { Current = &arena; }
+	static void UseHeap() { Current = nullptr; }
+
+	static const size_t Alignment = alignof(void*) > alignof(unsigned long) ? alignof(void*) : alignof(unsigned long);
+
+private:
+	uint8_t* _buffer;
+	size_t _capacity;
+	size_t _used = 0;
+	size_t _highWaterMark = 0;
+};
+
+template<size_t N>
+class SyncStaticArena : public SyncArena
+{
+public:
+	SyncStaticArena() : SyncArena(_storage, N) {}
+
+private:
+	alignas(SyncArena::Alignment) uint8_t _storage[N];
+};
+
+// Creates a node in the current arena (or in the heap if there is none), nullptr if the arena is full
+template<typename T, typename... Args>
+T* SyncTryNew(Args&&... args)
+{
+	if (SyncArena::Current == nullptr) return new T(SYNC_FORWARD(Args, args)...);
+
+	void* memory = SyncArena::Current->Allocate(sizeof(T));
+#if SYNC_ARENA_HEAP_FALLBACK
+	if (memory == nullptr) return new T(SYNC_FORWARD(Args, args)...);
+#endif
+	if (memory == nullptr) return nullptr;
+	return new (memory) T(SYNC_FORWARD(Args, args)...);
+}
+
+[[noreturn]] void SyncArenaOverflow(size_t size);
+
+// Creates a node in the current arena (or in the heap if there is none), a full arena is reported to the OverflowHandler
+// and then halts the sketch in a delay() loop, as the node can not be returned
+template<typename T, typename... Args>
+T& SyncNew(Args&&... args)
+{
+	T* node = SyncTryNew<T>(SYNC_FORWARD(Args, args)...);
+	if (node == nullptr) SyncArenaOverflow(sizeof(T));
+	return *node;
+}
+#endif
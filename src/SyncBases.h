@@ -1,147 +1,587 @@
-/***************************************************
-Copyright (c) 2019 Luis Llamas
-(www.luisllamas.es)
-Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
-Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
- ****************************************************/
-
-#ifndef _SYNCBASES_h
-#define _SYNCBASES_h
-
-#if defined(ARDUINO) && ARDUINO >= 100
-	#include "Arduino.h"
-#else
-	#include "WProgram.h"
-#endif
-
-#pragma region Forward definitions
-class SyncTransformationSpeed;
-class SyncTransformationScaleY;
-class SyncTransformationOffsetY;
-class SyncTransformationSliceX;
-class SyncTransformationDelay;
-class SyncTransformationInverse;
-class SyncTransformationReverse;
-class SyncConcatenate;
-class SyncRepeatN;
-class SyncRepeatInfinite;
-class SyncMirroring;
-class SyncConcatenate;
-#pragma endregion
-
-class ISyncFunction
-{
-public:
-	
-	virtual float GetValue() = 0;
-	virtual float GetValue(unsigned long overWriteMillis) = 0;
-	virtual unsigned long GetElapsed() = 0;
-
-private:
-	virtual float Calculate(unsigned long elapsedMillis) = 0;
-
-protected:
-	virtual ~ISyncFunction() {}
-};
-
-
-class SyncFunction : ISyncFunction
-{
-public:
-	SyncFunction(unsigned long interval) : Interval(interval), StarTime(millis()) {}
-
-	unsigned long Interval;
-	bool IsActive = true;
-
-	virtual void Reset()
-	{
-		
-	}
-
-	virtual void Restart()
-	{
-		StarTime = millis();
-	}
-
-	SyncConcatenate operator +(SyncFunction& op);
-
-	float GetValue() override final
-	{
-		return GetValue(GetElapsed());
-	}
-
-	float GetValue(unsigned long elapsedMillis) override final
-	{
-		//if (!IsActive) return 0.0;
-		return Calculate(elapsedMillis);
-	}
-
-	unsigned long GetElapsed() override
-	{
-		return static_cast<unsigned long> (millis() - StarTime);
-	}
-
-	// "Fluent" behavior
-	SyncTransformationSpeed& Speed(float scaleFactor);
-	SyncTransformationScaleY& ScaleY(float scaleFactor);
-	SyncTransformationOffsetY& OffsetY(float offset);
-	SyncTransformationSliceX& SliceX(long offset);
-	SyncTransformationDelay& Delay(unsigned long delay);
-	SyncTransformationInverse& Inverse();
-	SyncTransformationReverse& Reverse();
-
-	SyncRepeatN& Repeat(unsigned int repetitions);
-	SyncRepeatInfinite& Repeat();
-	SyncMirroring& Mirroring();
-
-	unsigned long StarTime;
-
-protected:
-	virtual ~SyncFunction() {}
-
-	float Calculate(unsigned long elapsedMillis) override { return 0.0; }
-
-};
-
-
-class SyncTransformation : public SyncFunction
-{
-public:
-
-	void Restart() override
-	{
-		StarTime = millis();
-		//_op1.StarTime = StarTime;
-	}
-
-
-	SyncTransformation(SyncFunction& op1) : SyncFunction(op1.Interval), _op1(op1) {}
-
-	float Calculate(unsigned long elapsedMillis) override = 0;
-
-	SyncFunction & _op1;
-};
-
-
-class SyncOperation : public SyncFunction
-{
-public:
-
-	void Restart() override
-	{
-		StarTime = millis();
-		/*_op1.StarTime = StarTime;
-		_op2.StarTime = StarTime;*/
-	}
-
-
-	SyncOperation(SyncFunction& op1, SyncFunction& op2, unsigned long t) : SyncFunction(t), _op1(op1), _op2(op2) {}
-	SyncOperation(SyncFunction& op1, SyncFunction& op2) : SyncFunction(max(op1.Interval, op2.Interval)), _op1(op1), _op2(op2) {}
-
-	float Calculate(unsigned long elapsedMillis) override = 0;
-
-	SyncFunction & _op1;
-	SyncFunction & _op2;
-};
-#endif
-
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCBASES_h
+#define _SYNCBASES_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncMath.h"
+#include "SyncCurve.h"
+
+#ifndef SYNC_RENDER_CHUNK
+#define SYNC_RENDER_CHUNK 16
+#endif
+
+// Define as 1 to record, for every node, the calls and the time spent in GetValue, GetValueQ16 and Render
+#ifndef SYNC_INSTRUMENTATION
+#define SYNC_INSTRUMENTATION 0
+#endif
+
+// Time source of the instrumentation, may be replaced by a cycle counter where there is one
+#ifndef SYNC_INSTRUMENTATION_TIMER
+#define SYNC_INSTRUMENTATION_TIMER micros
+#endif
+
+// Define as 1 so nodes do not store a start time nor IsActive. Every node of a graph runs on the
+// time of its parent, and only roots (SyncRoot, SyncPlayer) keep a start time
+#ifndef SYNC_COMPACT_NODES
+#define SYNC_COMPACT_NODES 0
+#endif
+
+// Define as 1 to store intervals and time parameters in 16 bits, when every interval of the
+// patterns (including repetitions and concatenations) is lower than 65535 ticks
+#ifndef SYNC_SHORT_INTERVALS
+#define SYNC_SHORT_INTERVALS 0
+#endif
+
+#if SYNC_SHORT_INTERVALS
+typedef uint16_t SyncInterval;
+#else
+typedef unsigned long SyncInterval;
+#endif
+
+// Returned by GetNextChange when the output will not change anymore
+#define SYNC_NEVER 0xFFFFFFFFUL
+
+#pragma region Forward definitions
+class SyncTransformationSpeed;
+class SyncTransformationScaleY;
+class SyncTransformationOffsetY;
+class SyncTransformationSliceX;
+class SyncTransformationDelay;
+class SyncTransformationInverse;
+class SyncTransformationReverse;
+class SyncTransformationCurve;
+class SyncConcatenate;
+class SyncRepeatN;
+class SyncRepeatInfinite;
+class SyncMirroring;
+class SyncMemo;
+class SyncConcatenate;
+#pragma endregion
+
+// Concrete class of a node, to walk and rewrite graphs without RTTI
+// The values are stored in binary patterns (SyncPattern.h), add new types at the end
+enum class SyncNodeType : uint8_t
+{
+	Function,
+	Zeros,
+	Constant,
+	Delta,
+	Step,
+	Ramp,
+	InverseRamp,
+	Triangular,
+	Trapezium,
+	Sin,
+	Cos,
+	Wavetable,
+	Speed,
+	ScaleY,
+	OffsetY,
+	AffineY,
+	SliceX,
+	Delay,
+	Inverse,
+	Reverse,
+	RepeatN,
+	RepeatInfinite,
+	Mirroring,
+	Add,
+	Substract,
+	Max,
+	Min,
+	And,
+	Or,
+	Concatenate,
+	Program,
+	AddN,
+	MaxN,
+	MinN,
+	AndN,
+	OrN,
+	Sequence,
+	Memo,
+	Root,
+	Curve,
+	Easing,
+};
+
+// Time source of every SyncFunction, millis() unless replaced (e.g. by a mock clock in tests)
+// All the intervals and elapsed times of the library are ticks of this source, so using
+// micros() (or any other counter) changes the time unit of the whole hierarchy
+// Elapsed times are computed with unsigned differences, so the 32 bits wraparound is safe
+class SyncClock
+{
+public:
+	typedef unsigned long (*Source)();
+
+	static unsigned long Now()
+	{
+		return _source();
+	}
+
+	static void SetSource(Source source)
+	{
+		_source = source;
+	}
+
+	// Ticks from since to now, wrapping at 32 bits whatever the size of unsigned long
+	static unsigned long Elapsed(unsigned long since, unsigned long now)
+	{
+		return static_cast<uint32_t>(now - since);
+	}
+
+	// Evaluation frame, memoized nodes (SyncMemo) keep their result until the next one
+	static uint32_t GetFrame()
+	{
+		return _frame;
+	}
+
+	static void NextFrame()
+	{
+		_frame++;
+	}
+
+private:
+	static Source _source;
+	static uint32_t _frame;
+};
+
+// Splits elapsed times into periods of a given interval without dividing on every call
+// Power of two intervals use shift and mask. Otherwise the start of the current period is
+// cached, and moves forward one period at a time while the time goes forward monotonically.
+// Only a jump (backwards, or over more than one period) needs a division
+class SyncPeriod
+{
+public:
+	// Index of the period of the last Split()
+	unsigned long Index = 0;
+
+	// Shift of the intervals that are not a power of two
+	static const uint8_t NoShift = 0xFF;
+
+	// Time within its period
+	unsigned long Split(unsigned long elapsedMillis, unsigned long interval)
+	{
+		if (interval != _interval || _interval == 0) SetInterval(interval);
+		return Split(elapsedMillis, interval, _shift, _start, Index);
+	}
+
+	// Same split, with the state kept by the caller (e.g. in the instructions of a SyncProgram):
+	// the shift from ShiftOf(interval), and the start and index of the current period, both 0 at first
+	// An empty interval has no time within it, and starts a new period every millisecond
+	static unsigned long Split(unsigned long elapsedMillis, unsigned long interval, uint8_t shift, unsigned long& start, unsigned long& index)
+	{
+		if (interval == 0)
+		{
+			index = elapsedMillis;
+			return 0;
+		}
+
+		if (shift != NoShift)
+		{
+			index = elapsedMillis >> shift;
+			return elapsedMillis & (interval - 1);
+		}
+
+		if (elapsedMillis >= start)
+		{
+			const unsigned long local = elapsedMillis - start;
+			if (local < interval) return local;
+			if (local - interval < interval)
+			{
+				start += interval;
+				index++;
+				return local - interval;
+			}
+		}
+
+		index = elapsedMillis / interval;
+		start = index * interval;
+		return elapsedMillis - start;
+	}
+
+	static uint8_t ShiftOf(unsigned long interval)
+	{
+		if (interval == 0 || (interval & (interval - 1)) != 0) return NoShift;
+
+		uint8_t shift = 0;
+		while ((1UL << shift) < interval) shift++;
+		return shift;
+	}
+
+private:
+	SyncInterval _interval = 0;
+	unsigned long _start = 0;
+	uint8_t _shift = NoShift;
+
+	void SetInterval(unsigned long interval)
+	{
+		_interval = interval;
+		_start = 0;
+		Index = 0;
+		_shift = ShiftOf(interval);
+	}
+};
+
+
+#if SYNC_INSTRUMENTATION
+// Cost of a node, in SYNC_INSTRUMENTATION_TIMER units, including the cost of its operands
+struct SyncNodeStats
+{
+	uint32_t Calls = 0;
+	uint32_t Samples = 0;
+	uint32_t Total = 0;
+	uint32_t Max = 0;
+
+	void Record(uint32_t cost, size_t samples)
+	{
+		Calls++;
+		Samples += samples;
+		Total += cost;
+		if (cost > Max) Max = cost;
+	}
+
+	void Clear()
+	{
+		Calls = Samples = Total = Max = 0;
+	}
+};
+#endif
+
+
+class ISyncFunction
+{
+public:
+	
+	virtual float GetValue() = 0;
+	virtual float GetValue(unsigned long overWriteMillis) = 0;
+	virtual unsigned long GetElapsed() = 0;
+	virtual void Render(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) = 0;
+	virtual int32_t GetValueQ16() = 0;
+	virtual int32_t GetValueQ16(unsigned long overWriteMillis) = 0;
+	virtual unsigned long GetNextChange() = 0;
+	virtual unsigned long GetNextChange(unsigned long overWriteMillis) = 0;
+
+private:
+	virtual float Calculate(unsigned long elapsedMillis) = 0;
+	virtual int32_t CalculateQ16(unsigned long elapsedMillis) = 0;
+	virtual unsigned long CalculateNextChange(unsigned long elapsedMillis) = 0;
+	virtual void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) = 0;
+
+protected:
+	virtual ~ISyncFunction() {}
+};
+
+
+class SyncFunction : ISyncFunction
+{
+public:
+	SyncFunction(unsigned long interval) : Interval(interval) {}
+
+	SyncInterval Interval;
+#if !SYNC_COMPACT_NODES
+	bool IsActive = true;
+#endif
+
+	virtual void Reset()
+	{
+		
+	}
+
+	// Virtual, so classes derived from previous versions keep their override. The nodes of the library
+	// override RestartAt() instead, which is also called by the triggers (SyncApplyTrigger)
+	virtual void Restart()
+	{
+		RestartAt(SyncClock::Now());
+	}
+
+	// Restarts as if Restart() was called at a past time of the SyncClock, e.g. captured in an ISR
+	virtual void RestartAt(unsigned long nowMillis)
+	{
+#if !SYNC_COMPACT_NODES
+		StarTime = nowMillis;
+#endif
+	}
+
+	// Origin of the elapsed time of GetValue(), the start of the clock for nodes without a start time
+	virtual unsigned long GetStartTime() const
+	{
+#if SYNC_COMPACT_NODES
+		return 0;
+#else
+		return StarTime;
+#endif
+	}
+
+	SyncConcatenate operator +(SyncFunction& op) &;
+
+	float GetValue() override final
+	{
+		return GetValue(GetElapsed());
+	}
+
+	float GetValue(unsigned long elapsedMillis) override final
+	{
+		//if (!IsActive) return 0.0;
+#if SYNC_INSTRUMENTATION
+		const uint32_t start = SYNC_INSTRUMENTATION_TIMER();
+		const float value = Calculate(elapsedMillis);
+		Stats.Record(SYNC_INSTRUMENTATION_TIMER() - start, 1);
+		return value;
+#else
+		return Calculate(elapsedMillis);
+#endif
+	}
+
+	// Evaluates at an absolute time, so several functions can share one clock read
+	float GetValueAt(unsigned long nowMillis)
+	{
+		return GetValue(SyncClock::Elapsed(GetStartTime(), nowMillis));
+	}
+
+	// Time until the output may change, so the caller can sleep meanwhile (SYNC_NEVER if it will not)
+	unsigned long GetNextChange() override final
+	{
+		const unsigned long elapsed = GetElapsed();
+		const unsigned long change = GetNextChange(elapsed);
+		return change == SYNC_NEVER ? SYNC_NEVER : change - elapsed;
+	}
+
+	// First elapsed time, after elapsedMillis, at which the output may change
+	unsigned long GetNextChange(unsigned long elapsedMillis) override final
+	{
+		return CalculateNextChange(elapsedMillis);
+	}
+
+	virtual SyncNodeType GetType() const { return SyncNodeType::Function; }
+
+	// Operands of transformations and operations
+	virtual uint8_t GetChildCount() const { return 0; }
+	virtual SyncFunction* GetChild(uint8_t index) const { return nullptr; }
+	virtual void SetChild(uint8_t index, SyncFunction* child) {}
+
+	// False for functions with state (e.g. SyncDelta), whose result must not be reused
+	virtual bool IsCacheable() const { return true; }
+
+	// True once the output has ended (e.g. a non repeated function after its Interval)
+	virtual bool IsFinished(unsigned long elapsedMillis)
+	{
+		return elapsedMillis > Interval;
+	}
+
+	// Same as GetValue in fixed point (1.0 = 65536), with no float operations
+	int32_t GetValueQ16() override final
+	{
+		return GetValueQ16(GetElapsed());
+	}
+
+	int32_t GetValueQ16(unsigned long elapsedMillis) override final
+	{
+#if SYNC_INSTRUMENTATION
+		const uint32_t start = SYNC_INSTRUMENTATION_TIMER();
+		const int32_t value = CalculateQ16(elapsedMillis);
+		Stats.Record(SYNC_INSTRUMENTATION_TIMER() - start, 1);
+		return value;
+#else
+		return CalculateQ16(elapsedMillis);
+#endif
+	}
+
+	// Value as a code for a PWM or DAC of the given bits (e.g. 8 for analogWrite)
+	uint16_t GetCode(uint8_t bits)
+	{
+		return SyncQ16ToCode(GetValueQ16(), bits);
+	}
+
+	// Fills out[i] with the value at startMillis + i * stepMillis
+	void Render(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override final
+	{
+#if SYNC_INSTRUMENTATION
+		const uint32_t start = SYNC_INSTRUMENTATION_TIMER();
+		CalculateBlock(out, n, startMillis, stepMillis);
+		Stats.Record(SYNC_INSTRUMENTATION_TIMER() - start, n);
+#else
+		CalculateBlock(out, n, startMillis, stepMillis);
+#endif
+	}
+
+	void Render(float* out, size_t n, unsigned long stepMillis)
+	{
+		Render(out, n, GetElapsed(), stepMillis);
+	}
+
+	unsigned long GetElapsed() override
+	{
+		return SyncClock::Elapsed(GetStartTime(), SyncClock::Now());
+	}
+
+	// "Fluent" behavior
+	SyncTransformationSpeed& Speed(float scaleFactor) &;
+	SyncTransformationScaleY& ScaleY(float scaleFactor) &;
+	SyncTransformationOffsetY& OffsetY(float offset) &;
+	SyncTransformationSliceX& SliceX(long offset) &;
+	SyncTransformationDelay& Delay(unsigned long delay) &;
+	SyncTransformationInverse& Inverse() &;
+	SyncTransformationReverse& Reverse() &;
+	SyncTransformationCurve& Curve(const SyncCurve& curve) &;
+
+	SyncRepeatN& Repeat(unsigned int repetitions) &;
+	SyncRepeatInfinite& Repeat() &;
+	SyncMirroring& Mirroring() &;
+	SyncMemo& Memoize() &;
+
+	// The nodes would keep a reference to a temporary, use SyncInline (SyncInline.h) to build them by value
+	void operator +(SyncFunction& op) && = delete;
+	void Speed(float scaleFactor) && = delete;
+	void ScaleY(float scaleFactor) && = delete;
+	void OffsetY(float offset) && = delete;
+	void SliceX(long offset) && = delete;
+	void Delay(unsigned long delay) && = delete;
+	void Inverse() && = delete;
+	void Reverse() && = delete;
+	void Curve(const SyncCurve& curve) && = delete;
+	void Repeat(unsigned int repetitions) && = delete;
+	void Repeat() && = delete;
+	void Mirroring() && = delete;
+	void Memoize() && = delete;
+
+#if !SYNC_COMPACT_NODES
+	unsigned long StarTime = SyncClock::Now();
+#endif
+
+#if SYNC_INSTRUMENTATION
+	SyncNodeStats Stats;
+#endif
+
+protected:
+	virtual ~SyncFunction() {}
+
+	float Calculate(unsigned long elapsedMillis) override { return 0.0; }
+
+	// Unless a function knows better, its output may change in the next millisecond
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override { return elapsedMillis + 1; }
+
+	// Change of an operand evaluated offset millis later than its parent
+	static unsigned long ShiftChange(unsigned long change, unsigned long offset)
+	{
+		return change == SYNC_NEVER ? SYNC_NEVER : change + offset;
+	}
+
+	// Elapsed time of an operand at the same instant, relative to its own StarTime
+	unsigned long ElapsedOf(const SyncFunction& op, unsigned long elapsedMillis) const
+	{
+#if SYNC_COMPACT_NODES
+		return elapsedMillis;
+#else
+		const unsigned long elapsed = SyncClock::Elapsed(op.StarTime, StarTime + elapsedMillis);
+		return elapsed > 0x7FFFFFFFUL ? 0 : elapsed;
+#endif
+	}
+
+	// Functions without an integer implementation fall back to the float one
+	int32_t CalculateQ16(unsigned long elapsedMillis) override { return SyncToQ16(Calculate(elapsedMillis)); }
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis) out[i] = Calculate(startMillis);
+	}
+
+	// Number of samples of a block, starting at startMillis, before reaching limitMillis
+	static size_t CountBefore(size_t n, unsigned long startMillis, unsigned long stepMillis, unsigned long limitMillis)
+	{
+		if (startMillis >= limitMillis) return 0;
+		if (stepMillis == 0) return n;
+		const unsigned long count = (limitMillis - startMillis + stepMillis - 1) / stepMillis;
+		return count < n ? count : n;
+	}
+
+	static void ReverseBlock(float* out, size_t n)
+	{
+		if (n < 2) return;
+		for (size_t i = 0, j = n - 1; i < j; i++, j--)
+		{
+			const float tmp = out[i];
+			out[i] = out[j];
+			out[j] = tmp;
+		}
+	}
+};
+
+
+class SyncTransformation : public SyncFunction
+{
+public:
+	SyncTransformation(SyncFunction& op1) : SyncFunction(op1.Interval), _op1(&op1) {}
+
+	float Calculate(unsigned long elapsedMillis) override = 0;
+
+	bool IsCacheable() const override { return _op1->IsCacheable(); }
+
+	uint8_t GetChildCount() const override { return 1; }
+	SyncFunction* GetChild(uint8_t index) const override { return _op1; }
+	void SetChild(uint8_t index, SyncFunction* child) override { _op1 = child; }
+
+	SyncFunction* _op1;
+};
+
+
+class SyncOperation : public SyncFunction
+{
+public:
+	SyncOperation(SyncFunction& op1, SyncFunction& op2, unsigned long t) : SyncFunction(t), _op1(&op1), _op2(&op2) {}
+	SyncOperation(SyncFunction& op1, SyncFunction& op2) : SyncFunction(max(op1.Interval, op2.Interval)), _op1(&op1), _op2(&op2) {}
+
+	float Calculate(unsigned long elapsedMillis) override = 0;
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(ElapsedOf(*_op1, elapsedMillis)) && _op2->IsFinished(ElapsedOf(*_op2, elapsedMillis));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		const unsigned long elapsed1 = ElapsedOf(*_op1, elapsedMillis);
+		const unsigned long elapsed2 = ElapsedOf(*_op2, elapsedMillis);
+		const unsigned long change1 = ShiftChange(_op1->GetNextChange(elapsed1), elapsedMillis - elapsed1);
+		const unsigned long change2 = ShiftChange(_op2->GetNextChange(elapsed2), elapsedMillis - elapsed2);
+		return min(change1, change2);
+	}
+
+	bool IsCacheable() const override { return _op1->IsCacheable() && _op2->IsCacheable(); }
+
+	uint8_t GetChildCount() const override { return 2; }
+	SyncFunction* GetChild(uint8_t index) const override { return index == 0 ? _op1 : _op2; }
+	void SetChild(uint8_t index, SyncFunction* child) override { (index == 0 ? _op1 : _op2) = child; }
+
+	SyncFunction* _op1;
+	SyncFunction* _op2;
+
+protected:
+	// Renders both operands chunk by chunk and merges them into out with combine(a, b)
+	template<typename TCombine>
+	void CombineBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis, TCombine combine)
+	{
+		float other[SYNC_RENDER_CHUNK];
+		for (size_t done = 0; done < n; done += SYNC_RENDER_CHUNK)
+		{
+			const size_t count = n - done < SYNC_RENDER_CHUNK ? n - done : SYNC_RENDER_CHUNK;
+			const unsigned long start = startMillis + done * stepMillis;
+			_op1->Render(out + done, count, ElapsedOf(*_op1, start), stepMillis);
+			_op2->Render(other, count, ElapsedOf(*_op2, start), stepMillis);
+			for (size_t i = 0; i < count; i++) out[done + i] = combine(out[done + i], other[i]);
+		}
+	}
+};
+#endif
+
@@ -0,0 +1,183 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCCHANNELSET_h
+#define _SYNCCHANNELSET_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+#include "SyncTrigger.h"
+
+// Evaluates N channels, each one with its own SyncFunction, reading the clock once per tick
+// Inactive (IsActive = false) channels output 0.0 without being evaluated. Finished channels are evaluated
+// once, and keep the value their function has after its Interval (e.g. the level of a SyncConstant)
+// With SYNC_COMPACT_NODES functions have no IsActive, detach or stop the channel instead
+// Events of a SyncTriggerQueue (e.g. posted by an ISR) restart the channels at the time they were captured
+template<uint8_t N>
+class SyncChannelSet
+{
+public:
+	typedef void (*Sink)(uint8_t channel, float value);
+
+	SyncChannelSet(unsigned long tickMillis = 0) : TickMillis(tickMillis)
+	{
+		for (uint8_t channel = 0; channel < N; channel++)
+		{
+			_functions[channel] = nullptr;
+			_sinks[channel] = nullptr;
+			_stopped[channel] = false;
+			_finished[channel] = false;
+			Values[channel] = 0.0;
+		}
+	}
+
+	void Attach(uint8_t channel, SyncFunction& function, Sink sink = nullptr)
+	{
+		_functions[channel] = &function;
+		_sinks[channel] = sink;
+		_stopped[channel] = false;
+		_finished[channel] = false;
+	}
+
+	void Detach(uint8_t channel)
+	{
+		_functions[channel] = nullptr;
+		_sinks[channel] = nullptr;
+		Values[channel] = 0.0;
+	}
+
+	// Applies an event to its channel, ignored if the channel has no function
+	void Apply(const SyncTriggerEvent& event)
+	{
+		if (event.Channel >= N || _functions[event.Channel] == nullptr) return;
+
+		SyncApplyTrigger(*_functions[event.Channel], event);
+		_stopped[event.Channel] = event.Action == SyncTriggerAction::Stop;
+		_finished[event.Channel] = false;
+		if (!_eventPending)
+		{
+			_eventPending = true;
+			_eventTime = event.Time;
+		}
+	}
+
+	// Applies all the events of the queue, then evaluates as Update()
+	template<uint8_t Size>
+	bool Update(SyncTriggerQueue<Size>& queue)
+	{
+		SyncTriggerEvent event;
+		while (queue.Take(event)) Apply(event);
+		return Update();
+	}
+
+	// Evaluates every channel if a tick is due, returns true if it did
+	bool Update()
+	{
+		const unsigned long now = SyncClock::Now();
+		const unsigned long late = SyncClock::Elapsed(_lastTick, now);
+		if (_ticks != 0 && late < TickMillis) return false;
+
+		// Ticks stay on the schedule of the first one, so a late Update() does not delay the next ones.
+		// Beyond MaxCatchUpTicks late ticks, the missed ones are skipped instead of run back to back
+		if (_ticks == 0 || TickMillis == 0) _lastTick = now;
+		else if (late >= TickMillis * (MaxCatchUpTicks + 1UL)) _lastTick = now - late % TickMillis;
+		else _lastTick += TickMillis;
+		SyncClock::NextFrame();
+
+		const unsigned long start = micros();
+		_evaluated = 0;
+		for (uint8_t channel = 0; channel < N; channel++)
+		{
+			SyncFunction* function = _functions[channel];
+			if (function == nullptr) continue;
+
+			const unsigned long elapsed = SyncClock::Elapsed(function->GetStartTime(), now);
+#if SYNC_COMPACT_NODES
+			if (_stopped[channel])
+#else
+			if (_stopped[channel] || !function->IsActive)
+#endif
+			{
+				Values[channel] = 0.0;
+				_finished[channel] = false;
+			}
+			else
+			{
+				const bool finished = function->IsFinished(elapsed);
+				if (!finished || !_finished[channel])
+				{
+					Values[channel] = function->GetValue(elapsed);
+					_evaluated++;
+				}
+				_finished[channel] = finished;
+			}
+
+			if (_sinks[channel] != nullptr) _sinks[channel](channel, Values[channel]);
+		}
+
+		// Latency from the first event applied since the last tick to the first output that includes it
+		if (_eventPending)
+		{
+			_eventPending = false;
+			_lastEventLatency = SyncClock::Elapsed(_eventTime, now);
+			if (_lastEventLatency > _maxEventLatency) _maxEventLatency = _lastEventLatency;
+		}
+
+		_ticks++;
+		_lastTickMicros = micros() - start;
+		if (_lastTickMicros > _maxTickMicros) _maxTickMicros = _lastTickMicros;
+		return true;
+	}
+
+	// Outputs of the last tick
+	float Values[N];
+
+	// Minimum time between ticks, 0 evaluates in every Update()
+	unsigned long TickMillis;
+
+	// Late ticks run by the next calls to Update(), to keep the schedule
+	static const uint8_t MaxCatchUpTicks = 4;
+
+	unsigned long GetTicks() const { return _ticks; }
+	uint8_t GetEvaluatedChannels() const { return _evaluated; }
+	unsigned long GetLastTickMicros() const { return _lastTickMicros; }
+	unsigned long GetMaxTickMicros() const { return _maxTickMicros; }
+
+	// In ticks of the SyncClock, from the capture of an event to the tick that outputs it
+	unsigned long GetLastEventLatency() const { return _lastEventLatency; }
+	unsigned long GetMaxEventLatency() const { return _maxEventLatency; }
+
+	void ResetStatistics()
+	{
+		_ticks = 0;
+		_maxTickMicros = 0;
+		_maxEventLatency = 0;
+	}
+
+private:
+	SyncFunction* _functions[N];
+	Sink _sinks[N];
+	bool _stopped[N];
+	bool _finished[N];
+
+	unsigned long _lastTick = 0;
+	unsigned long _ticks = 0;
+	unsigned long _lastTickMicros = 0;
+	unsigned long _maxTickMicros = 0;
+	uint8_t _evaluated = 0;
+
+	bool _eventPending = false;
+	unsigned long _eventTime = 0;
+	unsigned long _lastEventLatency = 0;
+	unsigned long _maxEventLatency = 0;
+};
+#endif
@@ -0,0 +1,54 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncCurve.h"
+
+static int32_t Square(int32_t x)
+{
+	return SyncMulQ16(x, x);
+}
+
+static int32_t Cube(int32_t x)
+{
+	return SyncMulQ16(SyncMulQ16(x, x), x);
+}
+
+int32_t SyncCurve::ApplyQ16(int32_t value) const
+{
+	const int32_t x = value < 0 ? 0 : value > SYNC_Q16_ONE ? SYNC_Q16_ONE : value;
+	const int32_t inverse = SYNC_Q16_ONE - x;
+
+	switch (Type)
+	{
+	case SyncCurveType::Gamma:
+		return SyncPowQ16(x, P1);
+	case SyncCurveType::ExponentialIn:
+		return x == 0 ? 0 : SyncExp2Q16(10 * x - 10 * SYNC_Q16_ONE);
+	case SyncCurveType::ExponentialOut:
+		return x == SYNC_Q16_ONE ? SYNC_Q16_ONE : SYNC_Q16_ONE - SyncExp2Q16(-10 * x);
+	case SyncCurveType::QuadraticIn:
+		return Square(x);
+	case SyncCurveType::QuadraticOut:
+		return SYNC_Q16_ONE - Square(inverse);
+	case SyncCurveType::QuadraticInOut:
+		return x < SYNC_Q16_ONE / 2 ? 2 * Square(x) : SYNC_Q16_ONE - 2 * Square(inverse);
+	case SyncCurveType::CubicIn:
+		return Cube(x);
+	case SyncCurveType::CubicOut:
+		return SYNC_Q16_ONE - Cube(inverse);
+	case SyncCurveType::CubicInOut:
+		return x < SYNC_Q16_ONE / 2 ? 4 * Cube(x) : SYNC_Q16_ONE - 4 * Cube(inverse);
+	case SyncCurveType::Bezier:
+	{
+		// 3(1-x)^2 x P1 + 3(1-x) x^2 P2 + x^3
+		const int32_t product = SyncMulQ16(x, inverse);
+		return 3 * SyncMulQ16(product, SyncMulQ16(inverse, P1) + SyncMulQ16(x, P2)) + Cube(x);
+	}
+	default:
+		return x;
+	}
+}
@@ -0,0 +1,51 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCCURVE_h
+#define _SYNCCURVE_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncMath.h"
+
+enum class SyncCurveType : uint8_t
+{
+	Linear,
+	Gamma,				// x^P1, e.g. 2.2 for the perceived brightness of a LED
+	ExponentialIn,		// 2^(10x - 10)
+	ExponentialOut,		// 1 - 2^(-10x)
+	QuadraticIn,
+	QuadraticOut,
+	QuadraticInOut,
+	CubicIn,
+	CubicOut,
+	CubicInOut,
+	Bezier,				// Cubic Bezier from 0.0 to 1.0, with control values P1 and P2
+};
+
+// Maps 0.0 - 1.0 into 0.0 - 1.0, in fixed point with tables and products (no pow or exp)
+// Inputs out of 0.0 - 1.0 are clamped
+struct SyncCurve
+{
+	SyncCurve(SyncCurveType type = SyncCurveType::Linear, float p1 = 0.0, float p2 = 0.0) : Type(type), P1(SyncToQ16(p1)), P2(SyncToQ16(p2)) {}
+
+	SyncCurveType Type;
+	int32_t P1;
+	int32_t P2;
+
+	int32_t ApplyQ16(int32_t value) const;
+
+	float Apply(float value) const
+	{
+		return SyncQ16ToFloat(ApplyQ16(SyncToQ16(value)));
+	}
+};
+#endif
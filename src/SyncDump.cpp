@@ -0,0 +1,201 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncDump.h"
+#include "SyncFunctions.h"
+#include "SyncTransformation.h"
+#include "SyncOperation.h"
+#include "SyncProgram.h"
+
+const __FlashStringHelper* SyncTypeName(SyncNodeType type)
+{
+	switch (type)
+	{
+	case SyncNodeType::Zeros: return F("Zeros");
+	case SyncNodeType::Constant: return F("Constant");
+	case SyncNodeType::Delta: return F("Delta");
+	case SyncNodeType::Step: return F("Step");
+	case SyncNodeType::Ramp: return F("Ramp");
+	case SyncNodeType::InverseRamp: return F("InverseRamp");
+	case SyncNodeType::Triangular: return F("Triangular");
+	case SyncNodeType::Trapezium: return F("Trapezium");
+	case SyncNodeType::Sin: return F("Sin");
+	case SyncNodeType::Cos: return F("Cos");
+	case SyncNodeType::Wavetable: return F("Wavetable");
+	case SyncNodeType::Speed: return F("Speed");
+	case SyncNodeType::ScaleY: return F("ScaleY");
+	case SyncNodeType::OffsetY: return F("OffsetY");
+	case SyncNodeType::AffineY: return F("AffineY");
+	case SyncNodeType::SliceX: return F("SliceX");
+	case SyncNodeType::Delay: return F("Delay");
+	case SyncNodeType::Inverse: return F("Inverse");
+	case SyncNodeType::Reverse: return F("Reverse");
+	case SyncNodeType::RepeatN: return F("RepeatN");
+	case SyncNodeType::RepeatInfinite: return F("RepeatInfinite");
+	case SyncNodeType::Mirroring: return F("Mirroring");
+	case SyncNodeType::Add: return F("Add");
+	case SyncNodeType::Substract: return F("Substract");
+	case SyncNodeType::Max: return F("Max");
+	case SyncNodeType::Min: return F("Min");
+	case SyncNodeType::And: return F("And");
+	case SyncNodeType::Or: return F("Or");
+	case SyncNodeType::Concatenate: return F("Concatenate");
+	case SyncNodeType::Program: return F("Program");
+	case SyncNodeType::AddN: return F("AddN");
+	case SyncNodeType::MaxN: return F("MaxN");
+	case SyncNodeType::MinN: return F("MinN");
+	case SyncNodeType::AndN: return F("AndN");
+	case SyncNodeType::OrN: return F("OrN");
+	case SyncNodeType::Sequence: return F("Sequence");
+	case SyncNodeType::Memo: return F("Memo");
+	case SyncNodeType::Root: return F("Root");
+	case SyncNodeType::Curve: return F("Curve");
+	case SyncNodeType::Easing: return F("Easing");
+	default: return F("Function");
+	}
+}
+
+static void PrintParameter(Print& out, const __FlashStringHelper* name, unsigned long value)
+{
+	out.print(' ');
+	out.print(name);
+	out.print(value);
+}
+
+static void PrintParameter(Print& out, const __FlashStringHelper* name, long value)
+{
+	out.print(' ');
+	out.print(name);
+	out.print(value);
+}
+
+static void PrintParameter(Print& out, const __FlashStringHelper* name, float value)
+{
+	out.print(' ');
+	out.print(name);
+	out.print(value, 4);
+}
+
+static void PrintCurve(Print& out, const SyncCurve& curve)
+{
+	PrintParameter(out, F("curve="), static_cast<unsigned long>(curve.Type));
+	if (curve.Type == SyncCurveType::Gamma || curve.Type == SyncCurveType::Bezier)
+		PrintParameter(out, F("p1="), SyncQ16ToFloat(curve.P1));
+	if (curve.Type == SyncCurveType::Bezier)
+		PrintParameter(out, F("p2="), SyncQ16ToFloat(curve.P2));
+}
+
+static void PrintParameters(SyncFunction& node, Print& out)
+{
+	switch (node.GetType())
+	{
+	case SyncNodeType::Constant:
+		PrintParameter(out, F("value="), static_cast<SyncConstant&>(node).GetLevel());
+		break;
+	case SyncNodeType::Step:
+		PrintParameter(out, F("t0="), static_cast<unsigned long>(static_cast<SyncStep&>(node).T0));
+		break;
+	case SyncNodeType::Triangular:
+		PrintParameter(out, F("t0="), static_cast<unsigned long>(static_cast<SyncTriangular&>(node)._t0));
+		PrintParameter(out, F("t1="), static_cast<unsigned long>(static_cast<SyncTriangular&>(node)._t1));
+		break;
+	case SyncNodeType::Trapezium:
+		PrintParameter(out, F("t0="), static_cast<unsigned long>(static_cast<SyncTrapezium&>(node)._t0));
+		PrintParameter(out, F("t1="), static_cast<unsigned long>(static_cast<SyncTrapezium&>(node)._t1));
+		PrintParameter(out, F("t2="), static_cast<unsigned long>(static_cast<SyncTrapezium&>(node)._t2));
+		break;
+	case SyncNodeType::Sin:
+		if (static_cast<SyncSin&>(node).Fast) out.print(F(" fast"));
+		break;
+	case SyncNodeType::Cos:
+		if (static_cast<SyncCos&>(node).Fast) out.print(F(" fast"));
+		break;
+	case SyncNodeType::Speed:
+		PrintParameter(out, F("factor="), static_cast<SyncTransformationSpeed&>(node).GetScaleFactor());
+		break;
+	case SyncNodeType::ScaleY:
+		PrintParameter(out, F("factor="), static_cast<SyncTransformationScaleY&>(node).GetScaleFactor());
+		break;
+	case SyncNodeType::OffsetY:
+		PrintParameter(out, F("offset="), static_cast<SyncTransformationOffsetY&>(node).GetOffset());
+		break;
+	case SyncNodeType::AffineY:
+		PrintParameter(out, F("factor="), static_cast<SyncTransformationAffineY&>(node).GetScaleFactor());
+		PrintParameter(out, F("offset="), static_cast<SyncTransformationAffineY&>(node).GetOffset());
+		break;
+	case SyncNodeType::SliceX:
+		PrintParameter(out, F("offset="), static_cast<SyncTransformationSliceX&>(node).GetOffset());
+		break;
+	case SyncNodeType::Delay:
+		PrintParameter(out, F("delay="), static_cast<unsigned long>(static_cast<SyncTransformationDelay&>(node).Delay));
+		break;
+	case SyncNodeType::RepeatN:
+		PrintParameter(out, F("count="), static_cast<unsigned long>(static_cast<SyncRepeatN&>(node).GetRepetitions()));
+		break;
+	case SyncNodeType::Curve:
+		PrintCurve(out, static_cast<SyncTransformationCurve&>(node).Shape);
+		break;
+	case SyncNodeType::Easing:
+		PrintCurve(out, static_cast<SyncEasing&>(node).Shape);
+		break;
+	case SyncNodeType::Program:
+		PrintParameter(out, F("instructions="), static_cast<unsigned long>(static_cast<SyncProgram&>(node).GetSize()));
+		break;
+	default:
+		break;
+	}
+}
+
+#if SYNC_INSTRUMENTATION
+static void PrintStats(SyncFunction& node, Print& out)
+{
+	uint32_t children = 0;
+	for (uint8_t index = 0; index < node.GetChildCount(); index++) children += node.GetChild(index)->Stats.Total;
+
+	// Operands shared with other parents may have cost more than this node
+	const uint32_t self = node.Stats.Total > children ? node.Stats.Total - children : 0;
+
+	PrintParameter(out, F("calls="), static_cast<unsigned long>(node.Stats.Calls));
+	PrintParameter(out, F("samples="), static_cast<unsigned long>(node.Stats.Samples));
+	PrintParameter(out, F("cost="), static_cast<unsigned long>(node.Stats.Total));
+	PrintParameter(out, F("self="), static_cast<unsigned long>(self));
+	PrintParameter(out, F("max="), static_cast<unsigned long>(node.Stats.Max));
+}
+#endif
+
+static void Dump(SyncFunction& node, Print& out, uint8_t depth)
+{
+	for (uint8_t level = 0; level < depth; level++) out.print(F("  "));
+	out.print(SyncTypeName(node.GetType()));
+	PrintParameter(out, F("interval="), static_cast<unsigned long>(node.Interval));
+	PrintParameters(node, out);
+#if SYNC_INSTRUMENTATION
+	PrintStats(node, out);
+#endif
+	out.println();
+
+	for (uint8_t index = 0; index < node.GetChildCount(); index++)
+	{
+		Dump(*node.GetChild(index), out, depth + 1);
+	}
+}
+
+void SyncDump(SyncFunction& root, Print& out)
+{
+	Dump(root, out, 0);
+}
+
+#if SYNC_INSTRUMENTATION
+void SyncClearStats(SyncFunction& root)
+{
+	root.Stats.Clear();
+	for (uint8_t index = 0; index < root.GetChildCount(); index++)
+	{
+		SyncClearStats(*root.GetChild(index));
+	}
+}
+#endif
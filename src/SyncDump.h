@@ -0,0 +1,61 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCDUMP_h
+#define _SYNCDUMP_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+
+// Print into a char buffer, always null terminated, extra characters are dropped
+class SyncBufferPrint : public Print
+{
+public:
+	SyncBufferPrint(char* buffer, size_t size) : _buffer(buffer), _size(size)
+	{
+		Clear();
+	}
+
+	size_t write(uint8_t c) override
+	{
+		if (_length + 1 >= _size) return 0;
+		_buffer[_length++] = c;
+		_buffer[_length] = '\0';
+		return 1;
+	}
+
+	size_t GetLength() const { return _length; }
+
+	void Clear()
+	{
+		_length = 0;
+		if (_size > 0) _buffer[0] = '\0';
+	}
+
+private:
+	char* _buffer;
+	size_t _size;
+	size_t _length = 0;
+};
+
+const __FlashStringHelper* SyncTypeName(SyncNodeType type);
+
+// One line per node, children indented under their parent (shared nodes are printed once per parent):
+//   Type interval=... parameters [calls=... samples=... cost=... self=... max=...]
+// cost and max include the operands, self is cost minus the cost of the operands
+// The counters are only printed with SYNC_INSTRUMENTATION, in SYNC_INSTRUMENTATION_TIMER units
+void SyncDump(SyncFunction& root, Print& out);
+
+#if SYNC_INSTRUMENTATION
+void SyncClearStats(SyncFunction& root);
+#endif
+#endif
@@ -1,197 +1,506 @@
-/***************************************************
-Copyright (c) 2019 Luis Llamas
-(www.luisllamas.es)
-Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
-Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
- ****************************************************/
-
-#ifndef _SYNCFUNCTIONS_h
-#define _SYNCFUNCTIONS_h
-
-#if defined(ARDUINO) && ARDUINO >= 100
-	#include "Arduino.h"
-#else
-	#include "WProgram.h"
-#endif
-
-#include "SyncBases.h"
-
-class SyncZeros : public SyncFunction
-{
-public:
-	SyncZeros(unsigned long delay) : SyncFunction(delay) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return 0.0;
-	};
-};
-
-class SyncConstant : public SyncFunction
-{
-public:
-	SyncConstant(unsigned long t, float value) : SyncFunction(t), Value(value > 1.0 ? 1.0 : value < 0.0 ? 0.0 : value) {}
-
-	float Value;
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return Value;
-	};
-};
-
-class SyncDelta : public SyncFunction
-{
-public:
-	SyncDelta(unsigned long t) : SyncFunction(t) { }
-
-
-	void Reset() override
-	{
-		_isTriggered = false;
-	}
-
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (_isTriggered) return 0.0;
-		_isTriggered = true;
-		return 1.0;
-	};
-
-	bool _isTriggered = false;
-};
-
-class SyncStep : public SyncFunction
-{
-public:
-	SyncStep(unsigned long t) : SyncFunction(t), T0(t/2) {}
-	SyncStep(unsigned long t0, unsigned long t) : SyncFunction(t), T0(t0) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return elapsedMillis < T0 ? 1.0 : 0.0;
-	};
-
-	unsigned long T0;
-};
-
-class SyncRamp : public SyncFunction
-{
-public:
-	SyncRamp(unsigned long t) : SyncFunction(t) {};
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-		return static_cast<float>(elapsedMillis) / Interval;
-	};
-};
-
-class SyncInverseRamp : public SyncFunction
-{
-public:
-	SyncInverseRamp(unsigned long t) : SyncFunction(t) {};
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-		return 1.0f - static_cast<float>(elapsedMillis) / Interval;
-	};
-};
-
-
-class SyncTriangular : public SyncFunction
-{
-public:
-	SyncTriangular(unsigned long t) : SyncFunction(t)
-	{
-		_t0 = t / 2;
-		_t1 = t - _t0;
-	}
-	SyncTriangular(unsigned long t0, unsigned long t1) : SyncFunction(t0 + t1)
-	{
-		_t0 = t0;
-		_t1 = t1;
-	};
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-		if (elapsedMillis < _t0)
-		{
-			return static_cast<float>(elapsedMillis) / _t0;
-		}
-		return 1.0f - (static_cast<float>(elapsedMillis) - _t0) / _t1;
-	};
-
-	unsigned long _t0;
-	unsigned long _t1;
-};
-
-class SyncTrapezium : public SyncFunction
-{
-public:
-	SyncTrapezium(unsigned long t) : SyncFunction(t)
-	{
-		_t0 = t / 3;
-		_t1 = _t0;
-		_t2 = t - _t0 - _t1;
-	};
-
-	SyncTrapezium(unsigned long t0, unsigned long t1, unsigned long t2) : SyncFunction(t0 + t1 + t2)
-	{
-		_t0 = t0;
-		_t1 = t1;
-		_t2 = t2;
-	};
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-		if (elapsedMillis < _t0)
-		{
-			return static_cast<float>(elapsedMillis) / _t0;
-		}
-		else if (elapsedMillis < _t0 + _t1)
-		{
-			return 1.0f;
-		}
-		else
-		{
-			return 1.0f - (static_cast<float>(elapsedMillis) - _t1 - _t0) / _t2;
-		}
-	};
-
-	unsigned long _t0;
-	unsigned long _t1;
-	unsigned long _t2;
-};
-
-
-class SyncSin : public SyncFunction
-{
-public:
-	SyncSin(unsigned long t) : SyncFunction(t) {};
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-		return 0.5* sin(2 * PI / Interval * elapsedMillis) + 0.5;
-	};
-};
-
-
-class SyncCos : public SyncFunction
-{
-public:
-	SyncCos(unsigned long t) : SyncFunction(t) {};
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-		return 0.5 * cos(2 * PI / Interval * elapsedMillis) + 0.5;
-	};
-};
-
-#endif
-
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCFUNCTIONS_h
+#define _SYNCFUNCTIONS_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+#include "SyncMath.h"
+
+class SyncZeros : public SyncFunction
+{
+public:
+	SyncZeros(unsigned long delay) : SyncFunction(delay) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Zeros; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return 0.0;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++) out[i] = 0.0;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return 0;
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return SYNC_NEVER;
+	}
+};
+
+class SyncConstant : public SyncFunction
+{
+public:
+	SyncConstant(unsigned long t, float value) : SyncFunction(t)
+	{
+		SetLevel(value);
+	}
+
+	float GetLevel() const { return _value; }
+
+	// Clamped to 0.0 - 1.0
+	void SetLevel(float value)
+	{
+		_value = value > 1.0 ? 1.0 : value < 0.0 ? 0.0 : value;
+		_valueQ16 = SyncToQ16(_value);
+	}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Constant; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return _value;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++) out[i] = _value;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return _valueQ16;
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return SYNC_NEVER;
+	}
+
+protected:
+	float _value;
+	int32_t _valueQ16;
+};
+
+class SyncDelta : public SyncFunction
+{
+public:
+	SyncDelta(unsigned long t) : SyncFunction(t) { }
+
+
+	void Reset() override
+	{
+		_isTriggered = false;
+	}
+
+
+	SyncNodeType GetType() const override { return SyncNodeType::Delta; }
+
+	bool IsCacheable() const override { return false; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (_isTriggered) return 0.0;
+		_isTriggered = true;
+		return 1.0;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++) out[i] = SyncDelta::Calculate(startMillis);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return SyncDelta::Calculate(elapsedMillis) > 0.0 ? SYNC_Q16_ONE : 0;
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _isTriggered ? SYNC_NEVER : elapsedMillis + 1;
+	}
+
+	bool _isTriggered = false;
+};
+
+class SyncStep : public SyncFunction
+{
+public:
+	SyncStep(unsigned long t) : SyncFunction(t), T0(t/2) {}
+	SyncStep(unsigned long t0, unsigned long t) : SyncFunction(t), T0(t0) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Step; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis < T0 ? 1.0 : 0.0;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis) out[i] = startMillis < T0 ? 1.0 : 0.0;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis < T0 ? SYNC_Q16_ONE : 0;
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis < T0 ? T0 : SYNC_NEVER;
+	}
+
+	SyncInterval T0;
+};
+
+class SyncRamp : public SyncFunction
+{
+public:
+	SyncRamp(unsigned long t) : SyncFunction(t) {};
+
+	SyncNodeType GetType() const override { return SyncNodeType::Ramp; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+		return static_cast<float>(elapsedMillis) / Interval;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		const float slope = 1.0f / Interval;
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis)
+			out[i] = startMillis > Interval ? 0.0f : startMillis * slope;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		return SyncRatioQ16(elapsedMillis, Interval);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+};
+
+class SyncInverseRamp : public SyncFunction
+{
+public:
+	SyncInverseRamp(unsigned long t) : SyncFunction(t) {};
+
+	SyncNodeType GetType() const override { return SyncNodeType::InverseRamp; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+		return 1.0f - static_cast<float>(elapsedMillis) / Interval;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		const float slope = 1.0f / Interval;
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis)
+			out[i] = startMillis > Interval ? 0.0f : 1.0f - startMillis * slope;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		return SYNC_Q16_ONE - SyncRatioQ16(elapsedMillis, Interval);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+};
+
+
+class SyncTriangular : public SyncFunction
+{
+public:
+	SyncTriangular(unsigned long t) : SyncFunction(t)
+	{
+		_t0 = t / 2;
+		_t1 = t - _t0;
+	}
+	SyncTriangular(unsigned long t0, unsigned long t1) : SyncFunction(t0 + t1)
+	{
+		_t0 = t0;
+		_t1 = t1;
+	};
+
+	SyncNodeType GetType() const override { return SyncNodeType::Triangular; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+		if (elapsedMillis < _t0)
+		{
+			return static_cast<float>(elapsedMillis) / _t0;
+		}
+		return 1.0f - (static_cast<float>(elapsedMillis) - _t0) / _t1;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis) out[i] = SyncTriangular::Calculate(startMillis);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		if (elapsedMillis < _t0)
+		{
+			return SyncRatioQ16(elapsedMillis, _t0);
+		}
+		if (_t1 == 0) return 0;
+		return SYNC_Q16_ONE - SyncRatioQ16(elapsedMillis - _t0, _t1);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+
+	SyncInterval _t0;
+	SyncInterval _t1;
+};
+
+class SyncTrapezium : public SyncFunction
+{
+public:
+	SyncTrapezium(unsigned long t) : SyncFunction(t)
+	{
+		_t0 = t / 3;
+		_t1 = _t0;
+		_t2 = t - _t0 - _t1;
+	};
+
+	SyncTrapezium(unsigned long t0, unsigned long t1, unsigned long t2) : SyncFunction(t0 + t1 + t2)
+	{
+		_t0 = t0;
+		_t1 = t1;
+		_t2 = t2;
+	};
+
+	SyncNodeType GetType() const override { return SyncNodeType::Trapezium; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+		if (elapsedMillis < _t0)
+		{
+			return static_cast<float>(elapsedMillis) / _t0;
+		}
+		else if (elapsedMillis < _t0 + _t1)
+		{
+			return 1.0f;
+		}
+		else
+		{
+			return 1.0f - (static_cast<float>(elapsedMillis) - _t1 - _t0) / _t2;
+		}
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis) out[i] = SyncTrapezium::Calculate(startMillis);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		if (elapsedMillis < _t0)
+		{
+			return SyncRatioQ16(elapsedMillis, _t0);
+		}
+		else if (elapsedMillis < _t0 + _t1)
+		{
+			return SYNC_Q16_ONE;
+		}
+		if (_t2 == 0) return 0;
+		return SYNC_Q16_ONE - SyncRatioQ16(elapsedMillis - _t1 - _t0, _t2);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return SYNC_NEVER;
+		if (elapsedMillis >= _t0 && elapsedMillis < _t0 + _t1) return _t0 + _t1;
+		return elapsedMillis + 1;
+	}
+
+	SyncInterval _t0;
+	SyncInterval _t1;
+	SyncInterval _t2;
+};
+
+
+class SyncSin : public SyncFunction
+{
+public:
+	// fast uses the table kernel of SyncMath.h, max error against the float output 5e-5 + 3.7e-10 * t
+	SyncSin(unsigned long t, bool fast = SYNC_FAST_TRIG) : SyncFunction(t), Fast(fast), _phaseInterval(t), _phaseStep(SyncPhaseStep(t)) {};
+
+	bool Fast;
+
+	SyncNodeType GetType() const override { return SyncNodeType::Sin; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+		if (Fast) return SyncFastSin(PhaseStep() * static_cast<uint32_t>(elapsedMillis));
+		return 0.5 * sin(2 * PI / Interval * elapsedMillis) + 0.5;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		if (Fast)
+		{
+			uint32_t phase = PhaseStep() * static_cast<uint32_t>(startMillis);
+			const uint32_t phaseStep = PhaseStep() * static_cast<uint32_t>(stepMillis);
+			for (size_t i = 0; i < n; i++, startMillis += stepMillis, phase += phaseStep)
+				out[i] = startMillis > Interval ? 0.0f : SyncFastSin(phase);
+			return;
+		}
+
+		const double w = 2 * PI / Interval;
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis)
+			out[i] = startMillis > Interval ? 0.0 : 0.5 * sin(w * startMillis) + 0.5;
+	}
+
+	// Always uses the table kernel
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		return SyncHalfSinQ16(PhaseStep() * static_cast<uint32_t>(elapsedMillis));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+
+protected:
+	SyncInterval _phaseInterval;
+	uint32_t _phaseStep;
+
+	// Recomputed when Interval is changed after construction
+	uint32_t PhaseStep()
+	{
+		if (_phaseInterval != Interval)
+		{
+			_phaseInterval = Interval;
+			_phaseStep = SyncPhaseStep(Interval);
+		}
+		return _phaseStep;
+	}
+};
+
+
+class SyncCos : public SyncFunction
+{
+public:
+	// fast uses the table kernel of SyncMath.h, max error against the float output 5e-5 + 3.7e-10 * t
+	SyncCos(unsigned long t, bool fast = SYNC_FAST_TRIG) : SyncFunction(t), Fast(fast), _phaseInterval(t), _phaseStep(SyncPhaseStep(t)) {};
+
+	bool Fast;
+
+	SyncNodeType GetType() const override { return SyncNodeType::Cos; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+		if (Fast) return SyncFastSin(PhaseStep() * static_cast<uint32_t>(elapsedMillis) + 0x40000000UL);
+		return 0.5 * cos(2 * PI / Interval * elapsedMillis) + 0.5;
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		if (Fast)
+		{
+			uint32_t phase = PhaseStep() * static_cast<uint32_t>(startMillis) + 0x40000000UL;
+			const uint32_t phaseStep = PhaseStep() * static_cast<uint32_t>(stepMillis);
+			for (size_t i = 0; i < n; i++, startMillis += stepMillis, phase += phaseStep)
+				out[i] = startMillis > Interval ? 0.0f : SyncFastSin(phase);
+			return;
+		}
+
+		const double w = 2 * PI / Interval;
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis)
+			out[i] = startMillis > Interval ? 0.0 : 0.5 * cos(w * startMillis) + 0.5;
+	}
+
+	// Always uses the table kernel
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		return SyncHalfSinQ16(PhaseStep() * static_cast<uint32_t>(elapsedMillis) + 0x40000000UL);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+
+protected:
+	SyncInterval _phaseInterval;
+	uint32_t _phaseStep;
+
+	// Recomputed when Interval is changed after construction
+	uint32_t PhaseStep()
+	{
+		if (_phaseInterval != Interval)
+		{
+			_phaseInterval = Interval;
+			_phaseStep = SyncPhaseStep(Interval);
+		}
+		return _phaseStep;
+	}
+};
+
+// Goes from 0.0 to 1.0 in t following a curve, e.g. SyncEasing(1000, SyncCurve(SyncCurveType::CubicInOut))
+class SyncEasing : public SyncFunction
+{
+public:
+	SyncEasing(unsigned long t, const SyncCurve& curve) : SyncFunction(t), Shape(curve) {};
+
+	SyncCurve Shape;
+
+	SyncNodeType GetType() const override { return SyncNodeType::Easing; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return SyncQ16ToFloat(CalculateQ16(elapsedMillis));
+	};
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis)
+			out[i] = startMillis > Interval ? 0.0f : SyncQ16ToFloat(Shape.ApplyQ16(SyncRatioQ16(startMillis, Interval)));
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		return Shape.ApplyQ16(SyncRatioQ16(elapsedMillis, Interval));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+};
+
+#endif
+
@@ -0,0 +1,216 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCINLINE_h
+#define _SYNCINLINE_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+#include "SyncTransformation.h"
+#include "SyncOperation.h"
+
+// Patterns built by value: every node stores a copy of its operands inside itself, so a whole
+// pattern is one object, without heap, arena or references to temporaries
+//   auto pwm = SyncInline(SyncStep(300, 1000)).Repeat();
+//   auto compound = (SyncInline(ramp) + constant + zeros).Repeat(3).ScaleY(3.0);
+// Copies (and moves) of a pattern copy its operands, and point the copy to its own operands
+// Operands from the runtime API (e.g. ramp.Repeat()) are copied too, but keep referencing their own operands
+
+template<typename TNode, typename TOp>
+class SyncInlineTransformation;
+
+template<typename TNode, typename TOp1, typename TOp2>
+class SyncInlineOperation;
+
+// Fluent methods of the inline nodes, returning new nodes by value
+template<typename TSelf>
+class SyncInlineFluent
+{
+public:
+	SyncInlineTransformation<SyncTransformationSpeed, TSelf> Speed(float scaleFactor) const
+	{
+		return SyncInlineTransformation<SyncTransformationSpeed, TSelf>(Self(), scaleFactor);
+	}
+
+	SyncInlineTransformation<SyncTransformationScaleY, TSelf> ScaleY(float scaleFactor) const
+	{
+		return SyncInlineTransformation<SyncTransformationScaleY, TSelf>(Self(), scaleFactor);
+	}
+
+	SyncInlineTransformation<SyncTransformationOffsetY, TSelf> OffsetY(float offset) const
+	{
+		return SyncInlineTransformation<SyncTransformationOffsetY, TSelf>(Self(), offset);
+	}
+
+	SyncInlineTransformation<SyncTransformationSliceX, TSelf> SliceX(long offset) const
+	{
+		return SyncInlineTransformation<SyncTransformationSliceX, TSelf>(Self(), offset);
+	}
+
+	SyncInlineTransformation<SyncTransformationDelay, TSelf> Delay(unsigned long delay) const
+	{
+		return SyncInlineTransformation<SyncTransformationDelay, TSelf>(Self(), delay);
+	}
+
+	SyncInlineTransformation<SyncTransformationInverse, TSelf> Inverse() const
+	{
+		return SyncInlineTransformation<SyncTransformationInverse, TSelf>(Self());
+	}
+
+	SyncInlineTransformation<SyncTransformationReverse, TSelf> Reverse() const
+	{
+		return SyncInlineTransformation<SyncTransformationReverse, TSelf>(Self());
+	}
+
+	SyncInlineTransformation<SyncTransformationCurve, TSelf> Curve(const SyncCurve& curve) const
+	{
+		return SyncInlineTransformation<SyncTransformationCurve, TSelf>(Self(), curve);
+	}
+
+	SyncInlineTransformation<SyncRepeatN, TSelf> Repeat(unsigned int repetitions) const
+	{
+		return SyncInlineTransformation<SyncRepeatN, TSelf>(Self(), repetitions);
+	}
+
+	SyncInlineTransformation<SyncRepeatInfinite, TSelf> Repeat() const
+	{
+		return SyncInlineTransformation<SyncRepeatInfinite, TSelf>(Self());
+	}
+
+	SyncInlineTransformation<SyncMirroring, TSelf> Mirroring() const
+	{
+		return SyncInlineTransformation<SyncMirroring, TSelf>(Self());
+	}
+
+	template<typename TOther>
+	SyncInlineOperation<SyncConcatenate, TSelf, TOther> operator +(const TOther& other) const
+	{
+		return SyncInlineOperation<SyncConcatenate, TSelf, TOther>(Self(), other);
+	}
+
+protected:
+	const TSelf& Self() const
+	{
+		return static_cast<const TSelf&>(*this);
+	}
+};
+
+// Storage of an operand, as a base so it is constructed before the node that references it
+template<typename TOp, uint8_t Index>
+struct SyncInlineOperand
+{
+	SyncInlineOperand(const TOp& op) : Operand(op) {}
+
+	TOp Operand;
+};
+
+// The inline fluent methods hide the ones of SyncFunction, which would allocate new nodes
+#define SYNC_INLINE_FLUENT(TSelf) \
+	using SyncInlineFluent<TSelf>::Speed; \
+	using SyncInlineFluent<TSelf>::ScaleY; \
+	using SyncInlineFluent<TSelf>::OffsetY; \
+	using SyncInlineFluent<TSelf>::SliceX; \
+	using SyncInlineFluent<TSelf>::Delay; \
+	using SyncInlineFluent<TSelf>::Inverse; \
+	using SyncInlineFluent<TSelf>::Reverse; \
+	using SyncInlineFluent<TSelf>::Curve; \
+	using SyncInlineFluent<TSelf>::Repeat; \
+	using SyncInlineFluent<TSelf>::Mirroring; \
+	using SyncInlineFluent<TSelf>::operator +;
+
+// A function (or any node) copied by value, the start of an inline pattern
+template<typename T>
+class SyncInlineNode : public T, public SyncInlineFluent<SyncInlineNode<T>>
+{
+public:
+	SyncInlineNode(const T& node) : T(node) {}
+
+	SYNC_INLINE_FLUENT(SyncInlineNode)
+};
+
+template<typename TNode, typename TOp>
+class SyncInlineTransformation : private SyncInlineOperand<TOp, 0>, public TNode, public SyncInlineFluent<SyncInlineTransformation<TNode, TOp>>
+{
+public:
+	template<typename... Args>
+	SyncInlineTransformation(const TOp& op, Args... args) : SyncInlineOperand<TOp, 0>(op), TNode(SyncInlineOperand<TOp, 0>::Operand, args...) {}
+
+	SyncInlineTransformation(const SyncInlineTransformation& other) : SyncInlineOperand<TOp, 0>(other), TNode(other)
+	{
+		TNode::SetChild(0, &this->SyncInlineOperand<TOp, 0>::Operand);
+	}
+
+	SyncInlineTransformation& operator=(const SyncInlineTransformation&) = delete;
+
+	SYNC_INLINE_FLUENT(SyncInlineTransformation)
+};
+
+template<typename TNode, typename TOp1, typename TOp2>
+class SyncInlineOperation : private SyncInlineOperand<TOp1, 0>, private SyncInlineOperand<TOp2, 1>, public TNode, public SyncInlineFluent<SyncInlineOperation<TNode, TOp1, TOp2>>
+{
+public:
+	SyncInlineOperation(const TOp1& op1, const TOp2& op2) : SyncInlineOperand<TOp1, 0>(op1), SyncInlineOperand<TOp2, 1>(op2),
+		TNode(SyncInlineOperand<TOp1, 0>::Operand, SyncInlineOperand<TOp2, 1>::Operand) {}
+
+	SyncInlineOperation(const SyncInlineOperation& other) : SyncInlineOperand<TOp1, 0>(other), SyncInlineOperand<TOp2, 1>(other), TNode(other)
+	{
+		TNode::SetChild(0, &this->SyncInlineOperand<TOp1, 0>::Operand);
+		TNode::SetChild(1, &this->SyncInlineOperand<TOp2, 1>::Operand);
+	}
+
+	SyncInlineOperation& operator=(const SyncInlineOperation&) = delete;
+
+	SYNC_INLINE_FLUENT(SyncInlineOperation)
+};
+
+template<typename T>
+SyncInlineNode<T> SyncInline(const T& node)
+{
+	return SyncInlineNode<T>(node);
+}
+
+template<typename TOp1, typename TOp2>
+SyncInlineOperation<SyncAdd, TOp1, TOp2> SyncInlineAdd(const TOp1& op1, const TOp2& op2)
+{
+	return SyncInlineOperation<SyncAdd, TOp1, TOp2>(op1, op2);
+}
+
+template<typename TOp1, typename TOp2>
+SyncInlineOperation<SyncSubstract, TOp1, TOp2> SyncInlineSubstract(const TOp1& op1, const TOp2& op2)
+{
+	return SyncInlineOperation<SyncSubstract, TOp1, TOp2>(op1, op2);
+}
+
+template<typename TOp1, typename TOp2>
+SyncInlineOperation<SyncMax, TOp1, TOp2> SyncInlineMax(const TOp1& op1, const TOp2& op2)
+{
+	return SyncInlineOperation<SyncMax, TOp1, TOp2>(op1, op2);
+}
+
+template<typename TOp1, typename TOp2>
+SyncInlineOperation<SyncMin, TOp1, TOp2> SyncInlineMin(const TOp1& op1, const TOp2& op2)
+{
+	return SyncInlineOperation<SyncMin, TOp1, TOp2>(op1, op2);
+}
+
+template<typename TOp1, typename TOp2>
+SyncInlineOperation<SyncAnd, TOp1, TOp2> SyncInlineAnd(const TOp1& op1, const TOp2& op2)
+{
+	return SyncInlineOperation<SyncAnd, TOp1, TOp2>(op1, op2);
+}
+
+template<typename TOp1, typename TOp2>
+SyncInlineOperation<SyncOr, TOp1, TOp2> SyncInlineOr(const TOp1& op1, const TOp2& op2)
+{
+	return SyncInlineOperation<SyncOr, TOp1, TOp2>(op1, op2);
+}
+#endif
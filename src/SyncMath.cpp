@@ -0,0 +1,30 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncMath.h"
+
+#define SYNC_SIN_ENTRIES_8(i) SyncSinEntry(i), SyncSinEntry(i + 1), SyncSinEntry(i + 2), SyncSinEntry(i + 3), SyncSinEntry(i + 4), SyncSinEntry(i + 5), SyncSinEntry(i + 6), SyncSinEntry(i + 7)
+
+const uint16_t SyncSinTable[SYNC_SIN_TABLE_SIZE + 1] PROGMEM =
+{
+	SYNC_SIN_ENTRIES_8(0), SYNC_SIN_ENTRIES_8(8), SYNC_SIN_ENTRIES_8(16), SYNC_SIN_ENTRIES_8(24),
+	SYNC_SIN_ENTRIES_8(32), SYNC_SIN_ENTRIES_8(40), SYNC_SIN_ENTRIES_8(48), SYNC_SIN_ENTRIES_8(56),
+	SyncSinEntry(64)
+};
+
+#define SYNC_LOG_ENTRIES_8(i) SyncLog2Entry(i), SyncLog2Entry(i + 1), SyncLog2Entry(i + 2), SyncLog2Entry(i + 3), SyncLog2Entry(i + 4), SyncLog2Entry(i + 5), SyncLog2Entry(i + 6), SyncLog2Entry(i + 7)
+#define SYNC_EXP_ENTRIES_8(i) SyncExp2Entry(i), SyncExp2Entry(i + 1), SyncExp2Entry(i + 2), SyncExp2Entry(i + 3), SyncExp2Entry(i + 4), SyncExp2Entry(i + 5), SyncExp2Entry(i + 6), SyncExp2Entry(i + 7)
+
+const uint32_t SyncLog2Table[SYNC_LOG_TABLE_SIZE + 1] PROGMEM =
+{
+	SYNC_LOG_ENTRIES_8(0), SYNC_LOG_ENTRIES_8(8), SyncLog2Entry(16)
+};
+
+const uint32_t SyncExp2Table[SYNC_LOG_TABLE_SIZE + 1] PROGMEM =
+{
+	SYNC_EXP_ENTRIES_8(0), SYNC_EXP_ENTRIES_8(8), SyncExp2Entry(16)
+};
@@ -0,0 +1,197 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCMATH_h
+#define _SYNCMATH_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+// Default kernel for SyncSin and SyncCos, define as true to use the table for every instance
+#ifndef SYNC_FAST_TRIG
+#define SYNC_FAST_TRIG false
+#endif
+
+// Quarter wave of sin, 64 segments, 1.0 = 65535, generated at compile time
+#define SYNC_SIN_TABLE_SIZE 64
+extern const uint16_t SyncSinTable[SYNC_SIN_TABLE_SIZE + 1] PROGMEM;
+
+// Fixed point values, 16 fractional bits (1.0 = 65536)
+#define SYNC_Q16_ONE 65536L
+
+inline int32_t SyncToQ16(float value)
+{
+	return static_cast<int32_t>(value * SYNC_Q16_ONE);
+}
+
+inline float SyncQ16ToFloat(int32_t value)
+{
+	return value * (1.0f / SYNC_Q16_ONE);
+}
+
+// a * b >> 16 from 16 x 16 bits products, 8 bits boards have no fast 64 bits multiply
+// Same result as the 64 bits product, the low word product only adds its carry
+inline int32_t SyncMulQ16(int32_t a, int32_t b)
+{
+	const int32_t aHigh = static_cast<int16_t>(static_cast<uint32_t>(a) >> 16);
+	const int32_t bHigh = static_cast<int16_t>(static_cast<uint32_t>(b) >> 16);
+	const uint32_t aLow = static_cast<uint16_t>(a);
+	const uint32_t bLow = static_cast<uint16_t>(b);
+
+	const uint32_t result = (static_cast<uint32_t>(aHigh * bHigh) << 16) + static_cast<uint32_t>(aHigh * static_cast<int32_t>(bLow))
+		+ static_cast<uint32_t>(static_cast<int32_t>(aLow) * bHigh) + ((aLow * bLow) >> 16);
+	return static_cast<int32_t>(result);
+}
+
+// num / den in Q16 without float, for 0 <= num <= den
+inline int32_t SyncRatioQ16(unsigned long num, unsigned long den)
+{
+	while (den > 0xFFFFUL)
+	{
+		num >>= 1;
+		den >>= 1;
+	}
+	return static_cast<int32_t>((static_cast<uint32_t>(num) << 16) / den);
+}
+
+// Output code for a PWM or DAC of the given bits, clamping to 0.0 - 1.0
+inline uint16_t SyncQ16ToCode(int32_t value, uint8_t bits)
+{
+	const uint32_t maxCode = (1UL << bits) - 1;
+	if (value <= 0) return 0;
+	if (value >= SYNC_Q16_ONE) return maxCode;
+	return static_cast<uint16_t>((static_cast<uint32_t>(value) * maxCode) >> 16);
+}
+
+// Taylor series of sin(x), accurate to 1e-9 in [0, PI/2]
+constexpr double SyncSinSeries(double x, double x2)
+{
+	return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110 * (1 - x2 / 156 * (1 - x2 / 210)))))));
+}
+
+constexpr uint16_t SyncSinEntry(int index)
+{
+	return static_cast<uint16_t>(65535.0 * SyncSinSeries(index * PI / (2 * SYNC_SIN_TABLE_SIZE), (index * PI / (2 * SYNC_SIN_TABLE_SIZE)) * (index * PI / (2 * SYNC_SIN_TABLE_SIZE))) + 0.5);
+}
+
+// Phase increment per time unit for a full turn (2^32) every interval, rounded to nearest, 0 for an empty interval
+// The rounding adds a phase error up to interval / 2^33 turns at the end of the interval
+constexpr uint32_t SyncPhaseStep(unsigned long interval)
+{
+	return interval == 0 ? 0 : 0xFFFFFFFFUL / interval + (0xFFFFFFFFUL % interval >= interval - 0xFFFFFFFFUL % interval ? 1 : 0);
+}
+
+// Offset of a SliceX as a positive shift lower than interval, so wrapping needs a subtraction instead of a modulo
+constexpr unsigned long SyncSliceShift(long offset, unsigned long interval)
+{
+	return interval == 0 ? 0
+		: offset >= 0 ? static_cast<unsigned long>(offset) % interval
+		: static_cast<unsigned long>(-offset) % interval == 0 ? 0 : interval - static_cast<unsigned long>(-offset) % interval;
+}
+
+// sin of a 32 bit phase (2^32 is a full turn), between -65535 and 65535
+// Linear interpolation of the quarter wave table, max error 1e-4 (5e-5 after scaling to 0.0 - 1.0)
+inline int32_t SyncSinQ16(uint32_t phase)
+{
+	const uint8_t quadrant = phase >> 30;
+	uint32_t x = phase & 0x3FFFFFFFUL;
+	if (quadrant & 1) x = 0x40000000UL - x;
+
+	const uint8_t index = x >> 24;
+	int32_t value = pgm_read_word(&SyncSinTable[index]);
+	if (index < SYNC_SIN_TABLE_SIZE)
+	{
+		const int32_t next = pgm_read_word(&SyncSinTable[index + 1]);
+		const int32_t fraction = (x >> 8) & 0xFFFF;
+		value += ((next - value) * fraction) >> 16;
+	}
+	return (quadrant & 2) ? -value : value;
+}
+
+// 0.5 * sin(phase) + 0.5 in Q16
+inline int32_t SyncHalfSinQ16(uint32_t phase)
+{
+	return (SyncSinQ16(phase) + SYNC_Q16_ONE) >> 1;
+}
+
+// 0.5 * sin(phase) + 0.5, the range of SyncSin
+inline float SyncFastSin(uint32_t phase)
+{
+	return 0.5f + SyncSinQ16(phase) * (0.5f / 65535);
+}
+
+// log2(1 + i / 16) and 2^(i / 16) - 1 in Q16, 16 segments, generated at compile time
+#define SYNC_LOG_TABLE_SIZE 16
+extern const uint32_t SyncLog2Table[SYNC_LOG_TABLE_SIZE + 1] PROGMEM;
+extern const uint32_t SyncExp2Table[SYNC_LOG_TABLE_SIZE + 1] PROGMEM;
+
+// ln(m) as 2 * atanh((m - 1) / (m + 1)), accurate to 1e-10 in [1, 2]
+constexpr double SyncLnSeries(double y, double y2)
+{
+	return 2 * y * (1 + y2 / 3 * (1 + y2 * 3 / 5 * (1 + y2 * 5 / 7 * (1 + y2 * 7 / 9 * (1 + y2 * 9 / 11 * (1 + y2 * 11 / 13 * (1 + y2 * 13 / 15 * (1 + y2 * 15 / 17))))))));
+}
+
+// Taylor series of exp(x), accurate to 1e-10 in [0, ln(2)]
+constexpr double SyncExpSeries(double x)
+{
+	return 1 + x * (1 + x / 2 * (1 + x / 3 * (1 + x / 4 * (1 + x / 5 * (1 + x / 6 * (1 + x / 7 * (1 + x / 8 * (1 + x / 9 * (1 + x / 10 * (1 + x / 11))))))))));
+}
+
+constexpr uint32_t SyncLog2Entry(int index)
+{
+	return static_cast<uint32_t>(SYNC_Q16_ONE * SyncLnSeries(index / (2.0 * SYNC_LOG_TABLE_SIZE + index), (index / (2.0 * SYNC_LOG_TABLE_SIZE + index)) * (index / (2.0 * SYNC_LOG_TABLE_SIZE + index))) / 0.69314718055994531 + 0.5);
+}
+
+constexpr uint32_t SyncExp2Entry(int index)
+{
+	return static_cast<uint32_t>(SYNC_Q16_ONE * (SyncExpSeries(index * 0.69314718055994531 / SYNC_LOG_TABLE_SIZE) - 1) + 0.5);
+}
+
+// Linear interpolation of a table of SYNC_LOG_TABLE_SIZE segments, fraction from 0 to 65535
+inline int32_t SyncInterpolateLogTable(const uint32_t* table, uint32_t fraction)
+{
+	const uint8_t index = fraction >> 12;
+	const int32_t value = pgm_read_dword(&table[index]);
+	const int32_t next = pgm_read_dword(&table[index + 1]);
+	return value + (((next - value) * static_cast<int32_t>(fraction & 0xFFF)) >> 12);
+}
+
+// log2 of a positive Q16 value, in Q16 (negative for values lower than 1.0), max error 1e-3
+inline int32_t SyncLog2Q16(int32_t value)
+{
+	uint32_t mantissa = value;
+	int32_t exponent = 0;
+	while (mantissa < static_cast<uint32_t>(SYNC_Q16_ONE)) { mantissa <<= 1; exponent--; }
+	while (mantissa >= static_cast<uint32_t>(2 * SYNC_Q16_ONE)) { mantissa >>= 1; exponent++; }
+	return exponent * SYNC_Q16_ONE + SyncInterpolateLogTable(SyncLog2Table, mantissa - SYNC_Q16_ONE);
+}
+
+// 2 to the power of a Q16 value lower or equal to 0, in Q16, max error 3e-4
+inline int32_t SyncExp2Q16(int32_t value)
+{
+	if (value >= 0) return SYNC_Q16_ONE;
+	const uint32_t magnitude = -value;
+	const uint32_t whole = magnitude >> 16;
+	const uint32_t fraction = magnitude & 0xFFFF;
+	if (whole >= 16) return 0;
+	if (fraction == 0) return SYNC_Q16_ONE >> whole;
+
+	// 2^-(whole + fraction) = 2^(1 - fraction) / 2^(whole + 1)
+	return (SYNC_Q16_ONE + SyncInterpolateLogTable(SyncExp2Table, SYNC_Q16_ONE - fraction)) >> (whole + 1);
+}
+
+// base^exponent for base in 0.0 - 1.0 and exponent > 0, all in Q16, without pow(), max error 5e-4
+inline int32_t SyncPowQ16(int32_t base, int32_t exponent)
+{
+	if (base <= 0) return 0;
+	if (base >= SYNC_Q16_ONE) return SYNC_Q16_ONE;
+	return SyncExp2Q16(SyncMulQ16(SyncLog2Q16(base), exponent));
+}
+#endif
@@ -1,98 +1,225 @@
-/***************************************************
-Copyright (c) 2019 Luis Llamas
-(www.luisllamas.es)
-Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
-Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
- ****************************************************/
-
-#ifndef _SYNCOPERATION_h
-#define _SYNCOPERATION_h
-
-#if defined(ARDUINO) && ARDUINO >= 100
-	#include "Arduino.h"
-#else
-	#include "WProgram.h"
-#endif
-
-#include "SyncBases.h"
-
-class SyncAdd : public SyncOperation
-{
-public:
-	SyncAdd(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return _op1.GetValue() + _op2.GetValue();
-	}
-};
-
-class SyncSubstract : public SyncOperation
-{
-public:
-	SyncSubstract(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		const auto rst = _op1.GetValue() - _op2.GetValue();
-		return rst < 0.0 ? 0.0 : rst;
-	}
-};
-
-class SyncMax : public SyncOperation
-{
-public:
-	SyncMax(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return max(_op1.GetValue(), _op2.GetValue());
-	}
-};
-
-class SyncMin : public SyncOperation
-{
-public:
-	SyncMin(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return min(_op1.GetValue(), _op2.GetValue());
-	}
-};
-
-class SyncAnd : public SyncOperation
-{
-public:
-	SyncAnd(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return ((_op1.GetValue() > 0.0)  &&  (_op2.GetValue() > 0.0)) ? 1.0 : 0.0;
-	}
-};
-
-class SyncOr : public SyncOperation
-{
-public:
-	SyncOr(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return ((_op1.GetValue() > 0.0) || (_op2.GetValue() > 0.0)) ? 1.0 : 0.0;
-	}
-};
-
-class SyncConcatenate : public SyncOperation
-{
-public:
-	SyncConcatenate(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) { Interval = op1.Interval + op2.Interval; }
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis <= _op1.Interval) return _op1.GetValue(elapsedMillis);
-		else return _op2.GetValue(elapsedMillis - _op1.Interval);
-	}
-};
-#endif
-
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCOPERATION_h
+#define _SYNCOPERATION_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+
+class SyncAdd : public SyncOperation
+{
+public:
+	SyncAdd(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Add; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValue(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValue(ElapsedOf(*_op2, elapsedMillis));
+		return value1 + value2;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		CombineBlock(out, n, startMillis, stepMillis, [](float a, float b) { return a + b; });
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValueQ16(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValueQ16(ElapsedOf(*_op2, elapsedMillis));
+		return value1 + value2;
+	}
+};
+
+class SyncSubstract : public SyncOperation
+{
+public:
+	SyncSubstract(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Substract; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValue(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValue(ElapsedOf(*_op2, elapsedMillis));
+		const auto rst = value1 - value2;
+		return rst < 0.0 ? 0.0 : rst;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		CombineBlock(out, n, startMillis, stepMillis, [](float a, float b) { return a - b < 0.0f ? 0.0f : a - b; });
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValueQ16(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValueQ16(ElapsedOf(*_op2, elapsedMillis));
+		return value1 > value2 ? value1 - value2 : 0;
+	}
+};
+
+class SyncMax : public SyncOperation
+{
+public:
+	SyncMax(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Max; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValue(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValue(ElapsedOf(*_op2, elapsedMillis));
+		return max(value1, value2);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		CombineBlock(out, n, startMillis, stepMillis, [](float a, float b) { return max(a, b); });
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValueQ16(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValueQ16(ElapsedOf(*_op2, elapsedMillis));
+		return max(value1, value2);
+	}
+};
+
+class SyncMin : public SyncOperation
+{
+public:
+	SyncMin(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Min; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValue(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValue(ElapsedOf(*_op2, elapsedMillis));
+		return min(value1, value2);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		CombineBlock(out, n, startMillis, stepMillis, [](float a, float b) { return min(a, b); });
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValueQ16(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValueQ16(ElapsedOf(*_op2, elapsedMillis));
+		return min(value1, value2);
+	}
+};
+
+class SyncAnd : public SyncOperation
+{
+public:
+	SyncAnd(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::And; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValue(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValue(ElapsedOf(*_op2, elapsedMillis));
+		return ((value1 > 0.0) && (value2 > 0.0)) ? 1.0 : 0.0;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		CombineBlock(out, n, startMillis, stepMillis, [](float a, float b) { return ((a > 0.0) && (b > 0.0)) ? 1.0f : 0.0f; });
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValueQ16(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValueQ16(ElapsedOf(*_op2, elapsedMillis));
+		return ((value1 > 0) && (value2 > 0)) ? SYNC_Q16_ONE : 0;
+	}
+};
+
+class SyncOr : public SyncOperation
+{
+public:
+	SyncOr(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Or; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValue(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValue(ElapsedOf(*_op2, elapsedMillis));
+		return ((value1 > 0.0) || (value2 > 0.0)) ? 1.0 : 0.0;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		CombineBlock(out, n, startMillis, stepMillis, [](float a, float b) { return ((a > 0.0) || (b > 0.0)) ? 1.0f : 0.0f; });
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		const auto value1 = _op1->GetValueQ16(ElapsedOf(*_op1, elapsedMillis));
+		const auto value2 = _op2->GetValueQ16(ElapsedOf(*_op2, elapsedMillis));
+		return ((value1 > 0) || (value2 > 0)) ? SYNC_Q16_ONE : 0;
+	}
+};
+
+class SyncConcatenate : public SyncOperation
+{
+public:
+	SyncConcatenate(SyncFunction& op1, SyncFunction& op2) : SyncOperation(op1, op2) { Interval = op1.Interval + op2.Interval; }
+
+	SyncNodeType GetType() const override { return SyncNodeType::Concatenate; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis <= _op1->Interval) return _op1->GetValue(elapsedMillis);
+		else return _op2->GetValue(elapsedMillis - _op1->Interval);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		const size_t first = CountBefore(n, startMillis, stepMillis, _op1->Interval + 1);
+		if (first > 0) _op1->Render(out, first, startMillis, stepMillis);
+		if (first < n) _op2->Render(out + first, n - first, startMillis + first * stepMillis - _op1->Interval, stepMillis);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis <= _op1->Interval) return _op1->GetValueQ16(elapsedMillis);
+		else return _op2->GetValueQ16(elapsedMillis - _op1->Interval);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis <= _op1->Interval) return false;
+		return _op2->IsFinished(elapsedMillis - _op1->Interval);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis <= _op1->Interval)
+		{
+			const unsigned long change = _op1->GetNextChange(elapsedMillis);
+			return min(change, _op1->Interval + 1UL);
+		}
+		return ShiftChange(_op2->GetNextChange(elapsedMillis - _op1->Interval), _op1->Interval);
+	}
+};
+#endif
+
@@ -0,0 +1,276 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCOPERATIONN_h
+#define _SYNCOPERATIONN_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+#include "SyncArena.h"
+
+// Operations over N operands, held in a contiguous array and evaluated in a single loop,
+// instead of a chain of N - 1 binary operations
+
+// Folding rule of each operation, for float and fixed point values
+struct SyncAddRule
+{
+	static const SyncNodeType Type = SyncNodeType::AddN;
+	static float Combine(float a, float b) { return a + b; }
+	static int32_t CombineQ16(int32_t a, int32_t b) { return a + b; }
+};
+
+struct SyncMaxRule
+{
+	static const SyncNodeType Type = SyncNodeType::MaxN;
+	static float Combine(float a, float b) { return a > b ? a : b; }
+	static int32_t CombineQ16(int32_t a, int32_t b) { return a > b ? a : b; }
+};
+
+struct SyncMinRule
+{
+	static const SyncNodeType Type = SyncNodeType::MinN;
+	static float Combine(float a, float b) { return a < b ? a : b; }
+	static int32_t CombineQ16(int32_t a, int32_t b) { return a < b ? a : b; }
+};
+
+struct SyncAndRule
+{
+	static const SyncNodeType Type = SyncNodeType::AndN;
+	static float Combine(float a, float b) { return a > 0.0f && b > 0.0f ? 1.0f : 0.0f; }
+	static int32_t CombineQ16(int32_t a, int32_t b) { return a > 0 && b > 0 ? SYNC_Q16_ONE : 0; }
+};
+
+struct SyncOrRule
+{
+	static const SyncNodeType Type = SyncNodeType::OrN;
+	static float Combine(float a, float b) { return a > 0.0f || b > 0.0f ? 1.0f : 0.0f; }
+	static int32_t CombineQ16(int32_t a, int32_t b) { return a > 0 || b > 0 ? SYNC_Q16_ONE : 0; }
+};
+
+template<uint8_t N>
+class SyncOperationN : public SyncFunction
+{
+public:
+	template<typename... Ops>
+	SyncOperationN(SyncFunction& op1, SyncFunction& op2, Ops&... ops) : SyncFunction(0), _ops{ &op1, &op2, &ops... }
+	{
+		static_assert(sizeof...(Ops) + 2 == N, "SyncOperationN needs N operands");
+	}
+
+	bool IsCacheable() const override
+	{
+		for (uint8_t i = 0; i < N; i++)
+		{
+			if (!_ops[i]->IsCacheable()) return false;
+		}
+		return true;
+	}
+
+	uint8_t GetChildCount() const override { return N; }
+	SyncFunction* GetChild(uint8_t index) const override { return _ops[index]; }
+	void SetChild(uint8_t index, SyncFunction* child) override { _ops[index] = child; }
+
+protected:
+	SyncFunction* _ops[N];
+};
+
+// Combines all the operands at the same instant, as SyncAdd, SyncMax...
+template<uint8_t N, typename TRule>
+class SyncCombineN : public SyncOperationN<N>
+{
+public:
+	template<typename... Ops>
+	SyncCombineN(SyncFunction& op1, SyncFunction& op2, Ops&... ops) : SyncOperationN<N>(op1, op2, ops...)
+	{
+		for (uint8_t i = 0; i < N; i++) this->Interval = max(this->Interval, _ops[i]->Interval);
+	}
+
+	SyncNodeType GetType() const override { return TRule::Type; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		float value = _ops[0]->GetValue(this->ElapsedOf(*_ops[0], elapsedMillis));
+		for (uint8_t i = 1; i < N; i++) value = TRule::Combine(value, _ops[i]->GetValue(this->ElapsedOf(*_ops[i], elapsedMillis)));
+		return value;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		float other[SYNC_RENDER_CHUNK];
+		for (size_t done = 0; done < n; done += SYNC_RENDER_CHUNK)
+		{
+			const size_t count = n - done < SYNC_RENDER_CHUNK ? n - done : SYNC_RENDER_CHUNK;
+			const unsigned long start = startMillis + done * stepMillis;
+			_ops[0]->Render(out + done, count, this->ElapsedOf(*_ops[0], start), stepMillis);
+			for (uint8_t op = 1; op < N; op++)
+			{
+				_ops[op]->Render(other, count, this->ElapsedOf(*_ops[op], start), stepMillis);
+				for (size_t i = 0; i < count; i++) out[done + i] = TRule::Combine(out[done + i], other[i]);
+			}
+		}
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		int32_t value = _ops[0]->GetValueQ16(this->ElapsedOf(*_ops[0], elapsedMillis));
+		for (uint8_t i = 1; i < N; i++) value = TRule::CombineQ16(value, _ops[i]->GetValueQ16(this->ElapsedOf(*_ops[i], elapsedMillis)));
+		return value;
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		for (uint8_t i = 0; i < N; i++)
+		{
+			if (!_ops[i]->IsFinished(this->ElapsedOf(*_ops[i], elapsedMillis))) return false;
+		}
+		return true;
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		unsigned long next = SYNC_NEVER;
+		for (uint8_t i = 0; i < N; i++)
+		{
+			const unsigned long elapsed = this->ElapsedOf(*_ops[i], elapsedMillis);
+			const unsigned long change = this->ShiftChange(_ops[i]->GetNextChange(elapsed), elapsedMillis - elapsed);
+			if (change < next) next = change;
+		}
+		return next;
+	}
+
+protected:
+	using SyncOperationN<N>::_ops;
+};
+
+template<uint8_t N> using SyncAddN = SyncCombineN<N, SyncAddRule>;
+template<uint8_t N> using SyncMaxN = SyncCombineN<N, SyncMaxRule>;
+template<uint8_t N> using SyncMinN = SyncCombineN<N, SyncMinRule>;
+template<uint8_t N> using SyncAndN = SyncCombineN<N, SyncAndRule>;
+template<uint8_t N> using SyncOrN = SyncCombineN<N, SyncOrRule>;
+
+// Plays each operand after the previous one, as a chain of SyncConcatenate
+// The operand of an instant is found by binary search over the cumulative intervals
+template<uint8_t N>
+class SyncSequence : public SyncOperationN<N>
+{
+public:
+	template<typename... Ops>
+	SyncSequence(SyncFunction& op1, SyncFunction& op2, Ops&... ops) : SyncOperationN<N>(op1, op2, ops...)
+	{
+		UpdateEnds();
+	}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Sequence; }
+
+	void SetChild(uint8_t index, SyncFunction* child) override
+	{
+		_ops[index] = child;
+		UpdateEnds();
+	}
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		const uint8_t index = Find(elapsedMillis);
+		return _ops[index]->GetValue(elapsedMillis - StartOf(index));
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		size_t done = 0;
+		while (done < n)
+		{
+			const unsigned long elapsed = startMillis + done * stepMillis;
+			const uint8_t index = Find(elapsed);
+			size_t count = index + 1 < N ? CountBefore(n - done, elapsed, stepMillis, _ends[index] + 1) : n - done;
+			if (count == 0) count = 1;
+			_ops[index]->Render(out + done, count, elapsed - StartOf(index), stepMillis);
+			done += count;
+		}
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		const uint8_t index = Find(elapsedMillis);
+		return _ops[index]->GetValueQ16(elapsedMillis - StartOf(index));
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis <= _ends[N - 2]) return false;
+		return _ops[N - 1]->IsFinished(elapsedMillis - _ends[N - 2]);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		const uint8_t index = Find(elapsedMillis);
+		const unsigned long start = StartOf(index);
+		const unsigned long change = this->ShiftChange(_ops[index]->GetNextChange(elapsedMillis - start), start);
+		return index + 1 < N ? min(change, _ends[index] + 1UL) : change;
+	}
+
+protected:
+	using SyncOperationN<N>::_ops;
+	using SyncFunction::CountBefore;
+
+	// _ends[i] is the elapsed time at which operand i ends
+	SyncInterval _ends[N];
+
+	void UpdateEnds()
+	{
+		unsigned long end = 0;
+		for (uint8_t i = 0; i < N; i++)
+		{
+			end += _ops[i]->Interval;
+			_ends[i] = end;
+		}
+		this->Interval = end;
+	}
+
+	unsigned long StartOf(uint8_t index) const
+	{
+		return index == 0 ? 0 : _ends[index - 1];
+	}
+
+	// First operand whose end is not before elapsedMillis, the last one after all of them
+	uint8_t Find(unsigned long elapsedMillis) const
+	{
+		uint8_t low = 0;
+		uint8_t high = N - 1;
+		while (low < high)
+		{
+			const uint8_t middle = (low + high) / 2;
+			if (elapsedMillis <= _ends[middle]) high = middle;
+			else low = middle + 1;
+		}
+		return low;
+	}
+};
+
+// Builders, e.g. auto& sum = SyncAddAll(sine, ramp, pulse);
+template<typename... Ops>
+SyncAddN<sizeof...(Ops)>& SyncAddAll(Ops&... ops) { return SyncNew<SyncAddN<sizeof...(Ops)>>(ops...); }
+
+template<typename... Ops>
+SyncMaxN<sizeof...(Ops)>& SyncMaxAll(Ops&... ops) { return SyncNew<SyncMaxN<sizeof...(Ops)>>(ops...); }
+
+template<typename... Ops>
+SyncMinN<sizeof...(Ops)>& SyncMinAll(Ops&... ops) { return SyncNew<SyncMinN<sizeof...(Ops)>>(ops...); }
+
+template<typename... Ops>
+SyncAndN<sizeof...(Ops)>& SyncAndAll(Ops&... ops) { return SyncNew<SyncAndN<sizeof...(Ops)>>(ops...); }
+
+template<typename... Ops>
+SyncOrN<sizeof...(Ops)>& SyncOrAll(Ops&... ops) { return SyncNew<SyncOrN<sizeof...(Ops)>>(ops...); }
+
+template<typename... Ops>
+SyncSequence<sizeof...(Ops)>& SyncSequenceOf(Ops&... ops) { return SyncNew<SyncSequence<sizeof...(Ops)>>(ops...); }
+#endif
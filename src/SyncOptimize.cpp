@@ -0,0 +1,207 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncOptimize.h"
+#include "SyncFunctions.h"
+#include "SyncTransformation.h"
+#include "SyncOperation.h"
+#include "SyncArena.h"
+
+unsigned int SyncCountNodes(SyncFunction& root)
+{
+	unsigned int count = 1;
+	for (uint8_t index = 0; index < root.GetChildCount(); index++)
+	{
+		count += SyncCountNodes(*root.GetChild(index));
+	}
+	return count;
+}
+
+// Y transformations as scale * value + offset
+static bool AsAffineY(SyncFunction& node, float& scale, float& offset)
+{
+	switch (node.GetType())
+	{
+	case SyncNodeType::ScaleY:
+		scale = static_cast<SyncTransformationScaleY&>(node).GetScaleFactor();
+		offset = 0.0;
+		return true;
+	case SyncNodeType::OffsetY:
+		scale = 1.0;
+		offset = static_cast<SyncTransformationOffsetY&>(node).GetOffset();
+		return true;
+	case SyncNodeType::Inverse:
+		scale = -1.0;
+		offset = 1.0;
+		return true;
+	case SyncNodeType::AffineY:
+		scale = static_cast<SyncTransformationAffineY&>(node).GetScaleFactor();
+		offset = static_cast<SyncTransformationAffineY&>(node).GetOffset();
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool AsConstant(SyncFunction& node, float& value)
+{
+	switch (node.GetType())
+	{
+	case SyncNodeType::Zeros:
+		value = 0.0;
+		return true;
+	case SyncNodeType::Constant:
+		value = static_cast<SyncConstant&>(node).GetLevel();
+		return true;
+	default:
+		return false;
+	}
+}
+
+// The replacement keeps the time frame of the node it replaces
+static SyncFunction& Replace(SyncFunction& node, SyncFunction& replacement)
+{
+	replacement.Interval = node.Interval;
+#if !SYNC_COMPACT_NODES
+	replacement.StarTime = node.StarTime;
+#endif
+	return replacement;
+}
+
+// A node can be dropped for its child only if the child runs on the same time frame, as the dropped node
+// may be a root or an operand, which are evaluated from their own StarTime
+static bool KeepsTimeFrame(SyncFunction& node, SyncFunction& child)
+{
+#if SYNC_COMPACT_NODES
+	return child.Interval == node.Interval;
+#else
+	return child.Interval == node.Interval && child.StarTime == node.StarTime && child.IsActive == node.IsActive;
+#endif
+}
+
+static SyncFunction& OptimizeAffineY(SyncFunction& node, float scale, float offset)
+{
+	SyncFunction* child = node.GetChild(0);
+	float childScale, childOffset;
+	const bool fuse = AsAffineY(*child, childScale, childOffset);
+	if (fuse)
+	{
+		offset = scale * childOffset + offset;
+		scale = scale * childScale;
+		child = child->GetChild(0);
+	}
+
+	if (scale == 1.0f && offset == 0.0f && KeepsTimeFrame(node, *child)) return *child;
+	if (!fuse) return node;
+	return Replace(node, SyncNew<SyncTransformationAffineY>(*child, scale, offset));
+}
+
+// The scaled time of a Speed node is exact when the fraction of its factor has no bits below 2^-32
+static bool HasExactFraction(float factor)
+{
+	const float scaled = (factor - floorf(factor)) * 4294967296.0f;
+	return scaled == floorf(scaled);
+}
+
+// Speed(inner).Speed(outer) truncates the time twice, and a single Speed(inner * outer) once. Both give the
+// same times only if the outer factor is a whole number, and the product and the inner factor are exact
+static bool CanFuseSpeed(float outer, float inner)
+{
+	return outer > 0.0f && outer == floorf(outer) && HasExactFraction(inner)
+		&& static_cast<double>(outer) * inner == static_cast<double>(outer * inner);
+}
+
+static SyncFunction& OptimizeSpeed(SyncTransformationSpeed& node)
+{
+	SyncFunction* child = node.GetChild(0);
+	float factor = node.GetScaleFactor();
+	const bool fuse = child->GetType() == SyncNodeType::Speed
+		&& CanFuseSpeed(factor, static_cast<SyncTransformationSpeed*>(child)->GetScaleFactor());
+	if (fuse)
+	{
+		factor *= static_cast<SyncTransformationSpeed*>(child)->GetScaleFactor();
+		child = child->GetChild(0);
+	}
+
+	if (factor == 1.0f && KeepsTimeFrame(node, *child)) return *child;
+	if (!fuse) return node;
+	return Replace(node, SyncNew<SyncTransformationSpeed>(*child, factor));
+}
+
+static SyncFunction& OptimizeDelay(SyncTransformationDelay& node)
+{
+	SyncFunction* child = node.GetChild(0);
+	if (child->GetType() != SyncNodeType::Delay) return node;
+
+	const unsigned long delay = node.Delay + static_cast<SyncTransformationDelay*>(child)->Delay;
+	return Replace(node, SyncNew<SyncTransformationDelay>(*child->GetChild(0), delay));
+}
+
+static SyncFunction& OptimizeOperation(SyncFunction& node)
+{
+	SyncFunction& op1 = *node.GetChild(0);
+	SyncFunction& op2 = *node.GetChild(1);
+
+	float value1, value2;
+	const bool constant1 = AsConstant(op1, value1);
+	const bool constant2 = AsConstant(op2, value2);
+	if (constant1 && constant2)
+	{
+		float value;
+		switch (node.GetType())
+		{
+		case SyncNodeType::Add: value = value1 + value2; break;
+		case SyncNodeType::Max: value = max(value1, value2); break;
+		default: value = min(value1, value2); break;
+		}
+
+		if (value == 0.0f) return Replace(node, SyncNew<SyncZeros>(node.Interval));
+		if (value > 0.0f && value <= 1.0f) return Replace(node, SyncNew<SyncConstant>(node.Interval, value));
+		return node;
+	}
+
+	// x + 0 is x, as long as x keeps the same time frame and Interval
+	if (node.GetType() == SyncNodeType::Add)
+	{
+		if (op2.GetType() == SyncNodeType::Zeros && KeepsTimeFrame(node, op1)) return op1;
+		if (op1.GetType() == SyncNodeType::Zeros && KeepsTimeFrame(node, op2)) return op2;
+	}
+	return node;
+}
+
+static SyncFunction& OptimizeNode(SyncFunction& node)
+{
+	for (uint8_t index = 0; index < node.GetChildCount(); index++)
+	{
+		node.SetChild(index, &OptimizeNode(*node.GetChild(index)));
+	}
+
+	float scale, offset;
+	if (AsAffineY(node, scale, offset)) return OptimizeAffineY(node, scale, offset);
+
+	switch (node.GetType())
+	{
+	case SyncNodeType::Speed:
+		return OptimizeSpeed(static_cast<SyncTransformationSpeed&>(node));
+	case SyncNodeType::Delay:
+		return OptimizeDelay(static_cast<SyncTransformationDelay&>(node));
+	case SyncNodeType::Add:
+	case SyncNodeType::Max:
+	case SyncNodeType::Min:
+		return OptimizeOperation(node);
+	default:
+		return node;
+	}
+}
+
+SyncFunction& SyncOptimize(SyncFunction& root, SyncOptimizeStats* stats)
+{
+	if (stats != nullptr) stats->NodesBefore = SyncCountNodes(root);
+	SyncFunction& optimized = OptimizeNode(root);
+	if (stats != nullptr) stats->NodesAfter = SyncCountNodes(optimized);
+	return optimized;
+}
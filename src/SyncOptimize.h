@@ -0,0 +1,36 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCOPTIMIZE_h
+#define _SYNCOPTIMIZE_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+
+struct SyncOptimizeStats
+{
+	unsigned int NodesBefore;
+	unsigned int NodesAfter;
+};
+
+// Nodes reachable from root (shared nodes are counted once per parent)
+unsigned int SyncCountNodes(SyncFunction& root);
+
+// Rewrites the graph in place and returns its new root, which may differ from root:
+// - chains of ScaleY, OffsetY and Inverse are fused into one SyncTransformationAffineY
+// - chains of Delay are fused into a single node, and chains of Speed too when the outer factor
+//   is a whole number, so the fused node gives exactly the same times
+// - identity ScaleY(1), OffsetY(0) and Speed(1) nodes are dropped
+// - Add, Max and Min of two constants are folded into a constant, Add of Zeros is dropped
+// New nodes are created with SyncNew (so they go to the current SyncArena, if any)
+SyncFunction& SyncOptimize(SyncFunction& root, SyncOptimizeStats* stats = nullptr);
+#endif
@@ -0,0 +1,182 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCOUTPUT_h
+#define _SYNCOUTPUT_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncMath.h"
+
+// Hardware receiving the output codes of a SyncOutput
+// Write() gets count consecutive channels starting at first, so bus devices (e.g. I2C PWM
+// expanders with auto increment registers) can send them in a single transaction
+class SyncOutputDevice
+{
+public:
+	SyncOutputDevice(uint8_t bits, uint8_t maxBurst = 0xFF) : Bits(bits), MaxBurst(maxBurst) {}
+
+	// Resolution of the outputs, codes go from 0 to 2^Bits - 1
+	const uint8_t Bits;
+
+	// Maximum channels per Write(), e.g. limited by the buffer of the bus
+	const uint8_t MaxBurst;
+
+	virtual void Write(uint8_t first, const uint16_t* codes, uint8_t count) = 0;
+
+protected:
+	virtual ~SyncOutputDevice() {}
+};
+
+// PWM pins of the board, one analogWrite per channel
+template<uint8_t N>
+class SyncAnalogWriteDevice : public SyncOutputDevice
+{
+public:
+	SyncAnalogWriteDevice(const uint8_t (&pins)[N], uint8_t bits = 8) : SyncOutputDevice(bits, 1)
+	{
+		for (uint8_t channel = 0; channel < N; channel++) _pins[channel] = pins[channel];
+	}
+
+	void Write(uint8_t first, const uint16_t* codes, uint8_t count) override
+	{
+		for (uint8_t i = 0; i < count; i++) analogWrite(_pins[first + i], codes[i]);
+	}
+
+private:
+	uint8_t _pins[N];
+};
+
+// Device without hardware, keeps the last codes and counts the transactions (for tests and benchmarks)
+template<uint8_t N>
+class SyncMockDevice : public SyncOutputDevice
+{
+public:
+	SyncMockDevice(uint8_t bits = 12, uint8_t maxBurst = 0xFF) : SyncOutputDevice(bits, maxBurst)
+	{
+		for (uint8_t channel = 0; channel < N; channel++) Codes[channel] = 0;
+	}
+
+	uint16_t Codes[N];
+	unsigned long Transactions = 0;
+	unsigned long ChannelWrites = 0;
+
+	void Write(uint8_t first, const uint16_t* codes, uint8_t count) override
+	{
+		for (uint8_t i = 0; i < count; i++) Codes[first + i] = codes[i];
+		Transactions++;
+		ChannelWrites += count;
+	}
+};
+
+// Quantizes N values (0.0 - 1.0) to the bits of a device, and only writes the channels whose code changed
+// Consecutive changed channels are sent together, in bursts of up to the MaxBurst of the device
+// Typically fed with the Values of a SyncChannelSet after each Update()
+template<uint8_t N>
+class SyncOutput
+{
+public:
+	SyncOutput(SyncOutputDevice& device) : _device(device)
+	{
+		for (uint8_t channel = 0; channel < N; channel++) _codes[channel] = 0;
+		ResetStatistics();
+	}
+
+	// Writes the channels that changed since the last call, returns the number of transactions
+	uint8_t Write(const float* values)
+	{
+		return WriteValues(values);
+	}
+
+	uint8_t WriteQ16(const int32_t* values)
+	{
+		return WriteValues(values);
+	}
+
+	// Forces a write of every channel on the next call (e.g. after a reset of the device)
+	void Invalidate()
+	{
+		_invalid = true;
+	}
+
+	uint16_t GetCode(uint8_t channel) const { return _codes[channel]; }
+
+	unsigned long GetWrittenChannels() const { return _written; }
+	unsigned long GetSavedChannels() const { return _saved; }
+	unsigned long GetTransactions() const { return _transactions; }
+
+	// Channel writes suppressed per second since the last ResetStatistics()
+	unsigned long GetSavedPerSecond() const
+	{
+		const unsigned long elapsed = millis() - _since;
+		return elapsed == 0 ? 0 : static_cast<unsigned long>(static_cast<uint64_t>(_saved) * 1000 / elapsed);
+	}
+
+	void ResetStatistics()
+	{
+		_written = 0;
+		_saved = 0;
+		_transactions = 0;
+		_since = millis();
+	}
+
+private:
+	SyncOutputDevice& _device;
+
+	static int32_t ToQ16(float value) { return SyncToQ16(value); }
+	static int32_t ToQ16(int32_t value) { return value; }
+
+	// Quantizes in place into _codes, without copies of the values on the stack. A run of changed
+	// channels is sent when an unchanged channel or the burst size of the device ends it
+	template<typename T>
+	uint8_t WriteValues(const T* values)
+	{
+		uint8_t transactions = 0;
+		uint8_t first = 0;
+		uint8_t count = 0;
+		for (uint8_t channel = 0; channel < N; channel++)
+		{
+			const uint16_t code = SyncQ16ToCode(ToQ16(values[channel]), _device.Bits);
+			if (!_invalid && code == _codes[channel])
+			{
+				_saved++;
+				if (count > 0) transactions += Send(first, count);
+				continue;
+			}
+
+			_codes[channel] = code;
+			if (count == 0) first = channel;
+			if (++count >= _device.MaxBurst) transactions += Send(first, count);
+		}
+		if (count > 0) transactions += Send(first, count);
+
+		_invalid = false;
+		_transactions += transactions;
+		return transactions;
+	}
+
+	uint8_t Send(uint8_t first, uint8_t& count)
+	{
+		_device.Write(first, _codes + first, count);
+		_written += count;
+		count = 0;
+		return 1;
+	}
+
+	uint16_t _codes[N];
+	bool _invalid = true;
+
+	unsigned long _written;
+	unsigned long _saved;
+	unsigned long _transactions;
+	unsigned long _since;
+};
+#endif
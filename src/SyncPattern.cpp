@@ -0,0 +1,257 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncPattern.h"
+
+#define SYNC_PATTERN_FAST 0x80
+
+// Number and kind of the parameters of each type, beyond its Interval
+enum class SyncPatternParameter : uint8_t { None, Unsigned, Signed, Float };
+
+static uint8_t ParametersOf(SyncNodeType code, SyncPatternParameter& kind)
+{
+	switch (code)
+	{
+	case SyncNodeType::Constant:
+	case SyncNodeType::ScaleY:
+	case SyncNodeType::OffsetY:
+		kind = SyncPatternParameter::Float;
+		return 1;
+	case SyncNodeType::AffineY:
+		kind = SyncPatternParameter::Float;
+		return 2;
+	case SyncNodeType::Step:
+	case SyncNodeType::Delay:
+	case SyncNodeType::RepeatN:
+		kind = SyncPatternParameter::Unsigned;
+		return 1;
+	case SyncNodeType::Triangular:
+		kind = SyncPatternParameter::Unsigned;
+		return 2;
+	case SyncNodeType::Trapezium:
+		kind = SyncPatternParameter::Unsigned;
+		return 3;
+	case SyncNodeType::SliceX:
+		kind = SyncPatternParameter::Signed;
+		return 1;
+	case SyncNodeType::Add:
+	case SyncNodeType::Substract:
+	case SyncNodeType::Max:
+	case SyncNodeType::Min:
+	case SyncNodeType::And:
+	case SyncNodeType::Or:
+		kind = SyncPatternParameter::Signed;
+		return 2;
+	case SyncNodeType::Speed:
+		// Whole and fraction parts are derived from the factor
+		kind = SyncPatternParameter::Float;
+		return 1;
+	default:
+		kind = SyncPatternParameter::None;
+		return 0;
+	}
+}
+
+class SyncPatternWriter
+{
+public:
+	SyncPatternWriter(uint8_t* buffer, size_t capacity) : _buffer(buffer), _capacity(capacity) {}
+
+	bool Overflow = false;
+	uint8_t Checksum = 0;
+
+	size_t GetSize() const { return _size; }
+
+	void Write(uint8_t value)
+	{
+		if (_size >= _capacity)
+		{
+			Overflow = true;
+			return;
+		}
+		_buffer[_size++] = value;
+		Checksum += value;
+	}
+
+	void WriteUnsigned(uint32_t value)
+	{
+		while (value >= 0x80)
+		{
+			Write(static_cast<uint8_t>(value) | 0x80);
+			value >>= 7;
+		}
+		Write(static_cast<uint8_t>(value));
+	}
+
+	void WriteSigned(int32_t value)
+	{
+		WriteUnsigned((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+	}
+
+	void WriteFloat(float value)
+	{
+		SyncParameter parameter;
+		parameter.F = value;
+		for (uint8_t i = 0; i < 4; i++) Write(static_cast<uint8_t>(parameter.U >> (8 * i)));
+	}
+
+private:
+	uint8_t* _buffer;
+	size_t _capacity;
+	size_t _size = 0;
+};
+
+// Reads from any source, keeping the running checksum
+class SyncPatternDecoder
+{
+public:
+	SyncPatternDecoder(SyncPatternReader& reader) : _reader(reader) {}
+
+	bool Error = false;
+	uint8_t Checksum = 0;
+
+	uint8_t Read()
+	{
+		const int value = _reader.Read();
+		if (value < 0)
+		{
+			Error = true;
+			return 0;
+		}
+		Checksum += static_cast<uint8_t>(value);
+		return static_cast<uint8_t>(value);
+	}
+
+	uint32_t ReadUnsigned()
+	{
+		uint32_t value = 0;
+		for (uint8_t shift = 0; shift < 35 && !Error; shift += 7)
+		{
+			const uint8_t next = Read();
+			value |= static_cast<uint32_t>(next & 0x7F) << shift;
+			if ((next & 0x80) == 0) return value;
+		}
+		Error = true;
+		return 0;
+	}
+
+	int32_t ReadSigned()
+	{
+		const uint32_t value = ReadUnsigned();
+		return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+	}
+
+	float ReadFloat()
+	{
+		SyncParameter parameter;
+		parameter.U = 0;
+		for (uint8_t i = 0; i < 4; i++) parameter.U |= static_cast<uint32_t>(Read()) << (8 * i);
+		return parameter.F;
+	}
+
+private:
+	SyncPatternReader& _reader;
+};
+
+size_t SyncPatternEncode(const SyncProgram& program, uint8_t* buffer, size_t capacity)
+{
+	SyncPatternWriter writer(buffer, capacity);
+	writer.Write('S');
+	writer.Write('W');
+	writer.Write(SYNC_PATTERN_VERSION);
+	writer.Write(program.GetSize());
+
+	const SyncInstruction* code = program.GetInstructions();
+	for (uint8_t i = 0; i < program.GetSize(); i++)
+	{
+		const SyncInstruction& instruction = code[i];
+		const bool fast = (instruction.Code == SyncNodeType::Sin || instruction.Code == SyncNodeType::Cos) && (instruction.Flags & SYNC_INSTRUCTION_FAST) != 0;
+		writer.Write(static_cast<uint8_t>(instruction.Code) | (fast ? SYNC_PATTERN_FAST : 0));
+		writer.WriteUnsigned(instruction.Interval);
+
+		SyncPatternParameter kind;
+		const uint8_t count = ParametersOf(instruction.Code, kind);
+		for (uint8_t p = 0; p < count; p++)
+		{
+			if (kind == SyncPatternParameter::Unsigned) writer.WriteUnsigned(instruction.P[p].U);
+			else if (kind == SyncPatternParameter::Signed) writer.WriteSigned(instruction.P[p].L);
+			else writer.WriteFloat(instruction.P[p].F);
+		}
+	}
+
+	writer.Write(writer.Checksum);
+	return writer.Overflow ? 0 : writer.GetSize();
+}
+
+bool SyncPatternLoad(SyncPatternReader& reader, SyncProgram& program)
+{
+	program.Clear();
+
+	SyncPatternDecoder decoder(reader);
+	const bool header = decoder.Read() == 'S' && decoder.Read() == 'W' && decoder.Read() == SYNC_PATTERN_VERSION;
+	const uint8_t size = decoder.Read();
+	if (!header || decoder.Error || size == 0 || size > program.GetCapacity()) return false;
+
+	// Nodes waiting for children, with the position of the next one
+	uint8_t parents[SYNC_PATTERN_MAX_DEPTH];
+	uint8_t nextChild[SYNC_PATTERN_MAX_DEPTH];
+	uint8_t depth = 0;
+
+	SyncInstruction* code = program.GetInstructions();
+	for (uint8_t i = 0; i < size; i++)
+	{
+		SyncInstruction& instruction = code[i];
+		const uint8_t type = decoder.Read();
+		instruction.Code = static_cast<SyncNodeType>(type & ~SYNC_PATTERN_FAST);
+		instruction.Flags = (type & SYNC_PATTERN_FAST) ? SYNC_INSTRUCTION_FAST : 0;
+		instruction.Interval = decoder.ReadUnsigned();
+		instruction.P[0].U = instruction.P[1].U = instruction.P[2].U = 0;
+
+		SyncPatternParameter kind;
+		const uint8_t count = ParametersOf(instruction.Code, kind);
+		for (uint8_t p = 0; p < count; p++)
+		{
+			if (kind == SyncPatternParameter::Unsigned) instruction.P[p].U = decoder.ReadUnsigned();
+			else if (kind == SyncPatternParameter::Signed) instruction.P[p].L = decoder.ReadSigned();
+			else
+			{
+				// Infinite or NaN floats would reach every sample, and the Interval of a Speed node is divided by its factor
+				instruction.P[p].F = decoder.ReadFloat();
+				if ((instruction.P[p].U & 0x7F800000UL) == 0x7F800000UL) return false;
+			}
+		}
+		if (instruction.Code == SyncNodeType::Speed && !(instruction.P[0].F > 0.0f)) return false;
+
+		// Link to the innermost node that still misses children
+		if (i > 0)
+		{
+			if (depth == 0) return false;
+			instruction.Parent = parents[depth - 1];
+			instruction.Child = nextChild[depth - 1]++;
+			if (nextChild[depth - 1] >= SyncProgram::ArityOf(code[instruction.Parent].Code)) depth--;
+		}
+		else
+		{
+			instruction.Parent = 0;
+			instruction.Child = 0;
+		}
+
+		const uint8_t arity = SyncProgram::ArityOf(instruction.Code);
+		if (decoder.Error || arity == 0xFF) return false;
+		if (arity > 0)
+		{
+			if (depth >= SYNC_PATTERN_MAX_DEPTH) return false;
+			parents[depth] = i;
+			nextChild[depth] = 0;
+			depth++;
+		}
+	}
+
+	const uint8_t checksum = decoder.Checksum;
+	if (decoder.Read() != checksum || decoder.Error || depth != 0) return false;
+	return program.Load(size);
+}
@@ -0,0 +1,78 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCPATTERN_h
+#define _SYNCPATTERN_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncProgram.h"
+
+// Binary pattern format:
+//   'S' 'W' version count, then count nodes in pre-order, then the sum of all the previous bytes
+// Each node is its type (high bit set for the fast Sin / Cos kernel), its Interval and its parameters
+// Integers are unsigned LEB128 varints (signed ones zigzag encoded), floats are 4 bytes little endian
+#define SYNC_PATTERN_VERSION 1
+
+// Deepest nesting of transformations and operations the loader accepts
+#ifndef SYNC_PATTERN_MAX_DEPTH
+#define SYNC_PATTERN_MAX_DEPTH 32
+#endif
+
+// Source of the bytes of a pattern. Read() returns -1 at the end of the data
+class SyncPatternReader
+{
+public:
+	virtual int Read() = 0;
+};
+
+// Pattern stored in RAM or PROGMEM
+class SyncMemoryReader : public SyncPatternReader
+{
+public:
+	SyncMemoryReader(const uint8_t* data, size_t size, bool progmem = false) : _data(data), _size(size), _progmem(progmem) {}
+
+	int Read() override
+	{
+		if (_position >= _size) return -1;
+		const uint8_t* address = _data + _position++;
+		return _progmem ? pgm_read_byte(address) : *address;
+	}
+
+private:
+	const uint8_t* _data;
+	size_t _size;
+	bool _progmem;
+	size_t _position = 0;
+};
+
+// Pattern received from a Serial port, a file, etc. Waits up to the timeout of the stream for each byte
+class SyncStreamReader : public SyncPatternReader
+{
+public:
+	SyncStreamReader(Stream& stream) : _stream(stream) {}
+
+	int Read() override
+	{
+		uint8_t value;
+		return _stream.readBytes(&value, 1) == 1 ? value : -1;
+	}
+
+private:
+	Stream& _stream;
+};
+
+// Decodes a pattern directly into the instructions of program, false if it is malformed or does not fit
+bool SyncPatternLoad(SyncPatternReader& reader, SyncProgram& program);
+
+// Encodes a compiled program, returns the bytes written or 0 if buffer is too small
+size_t SyncPatternEncode(const SyncProgram& program, uint8_t* buffer, size_t capacity);
+#endif
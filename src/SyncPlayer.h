@@ -0,0 +1,149 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCPLAYER_h
+#define _SYNCPLAYER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+
+// Plays a graph from an interrupt while the main loop builds and publishes the next one
+// Publish(), IsPending() and TakeRetired() are called from the main loop, Update() from the ISR
+// The handover uses single byte flags, which are atomic on single core boards, instead of locks:
+// the main loop only writes the pending graph while the flag is clear, and the ISR only reads it while it is set
+// The new graph starts at the next period of the active one (or at once), optionally crossfading both outputs
+class SyncPlayer
+{
+public:
+	SyncPlayer() {}
+	SyncPlayer(SyncFunction& graph) : _active(&graph), _activeStart(SyncClock::Now()) {}
+
+	// Replaces the graph published before, if it was not picked up yet
+	// The graph must be complete, and must not change while it is pending or active
+	void Publish(SyncFunction& graph, unsigned long fadeMillis = 0, bool atBoundary = true)
+	{
+		_ready = false;
+		_pending = &graph;
+		_pendingFade = fadeMillis;
+		_pendingAtBoundary = atBoundary;
+		_ready = true;
+	}
+
+	bool IsPending() const { return _ready; }
+	bool IsFading() const { return _fading; }
+
+	// Graph replaced by the last swap, once the ISR does not use it anymore (nullptr otherwise)
+	// After this call its nodes (or its arena) can be reused. Take it before publishing again
+	SyncFunction* TakeRetired()
+	{
+		if (_ready || _fading) return nullptr;
+		SyncFunction* retired = _retired;
+		_retired = nullptr;
+		return retired;
+	}
+
+	float Update()
+	{
+		return Update(SyncClock::Now());
+	}
+
+	float Update(unsigned long now)
+	{
+		Advance(now);
+		if (_active == nullptr) return 0.0;
+
+		const unsigned long elapsed = SyncClock::Elapsed(_activeStart, now);
+		const float value = _active->GetValue(elapsed);
+		if (!_fading) return value;
+
+		const float mix = static_cast<float>(elapsed) / _fade;
+		return value * mix + _previous->GetValue(SyncClock::Elapsed(_previousStart, now)) * (1.0f - mix);
+	}
+
+	// Same as Update in fixed point (1.0 = 65536), for ISRs without float operations
+	int32_t UpdateQ16(unsigned long now)
+	{
+		Advance(now);
+		if (_active == nullptr) return 0;
+
+		const unsigned long elapsed = SyncClock::Elapsed(_activeStart, now);
+		const int32_t value = _active->GetValueQ16(elapsed);
+		if (!_fading) return value;
+
+		const int32_t mix = SyncRatioQ16(elapsed, _fade);
+		const int32_t previous = _previous->GetValueQ16(SyncClock::Elapsed(_previousStart, now));
+		return previous + SyncMulQ16(value - previous, mix);
+	}
+
+private:
+	SyncFunction* volatile _pending = nullptr;
+	volatile unsigned long _pendingFade = 0;
+	volatile bool _pendingAtBoundary = true;
+	volatile bool _ready = false;
+
+	SyncFunction* _active = nullptr;
+	unsigned long _activeStart = 0;
+	SyncPeriod _period;
+	unsigned long _lastPeriod = 0;
+
+	SyncFunction* _previous = nullptr;
+	unsigned long _previousStart = 0;
+	unsigned long _fade = 0;
+	volatile bool _fading = false;
+
+	SyncFunction* volatile _retired = nullptr;
+
+	void Advance(unsigned long now)
+	{
+		const unsigned long elapsed = SyncClock::Elapsed(_activeStart, now);
+		if (_fading && elapsed >= _fade)
+		{
+			_retired = _previous;
+			_previous = nullptr;
+			_fading = false;
+		}
+
+		// Period boundaries are tracked on every call, so a late publish does not see an old one
+		bool boundary = _active == nullptr || _active->Interval == 0;
+		if (!boundary)
+		{
+			_period.Split(elapsed, _active->Interval);
+			boundary = _period.Index != _lastPeriod;
+			_lastPeriod = _period.Index;
+		}
+
+		if (!_ready || _fading) return;
+		if (_pendingAtBoundary && !boundary) return;
+		Swap(now);
+	}
+
+	void Swap(unsigned long now)
+	{
+		if (_pendingFade > 0 && _active != nullptr)
+		{
+			_previous = _active;
+			_previousStart = _activeStart;
+			_fade = _pendingFade;
+			_fading = true;
+		}
+		else
+		{
+			_retired = _active;
+		}
+
+		_active = _pending;
+		_activeStart = now;
+		_lastPeriod = 0;
+		_ready = false;
+	}
+};
+#endif
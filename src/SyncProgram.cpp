@@ -0,0 +1,377 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#include "SyncProgram.h"
+#include "SyncFunctions.h"
+#include "SyncTransformation.h"
+#include "SyncOperation.h"
+
+uint8_t SyncProgram::ArityOf(SyncNodeType code)
+{
+	switch (code)
+	{
+	case SyncNodeType::Zeros:
+	case SyncNodeType::Constant:
+	case SyncNodeType::Step:
+	case SyncNodeType::Ramp:
+	case SyncNodeType::InverseRamp:
+	case SyncNodeType::Triangular:
+	case SyncNodeType::Trapezium:
+	case SyncNodeType::Sin:
+	case SyncNodeType::Cos:
+		return 0;
+	case SyncNodeType::Speed:
+	case SyncNodeType::ScaleY:
+	case SyncNodeType::OffsetY:
+	case SyncNodeType::AffineY:
+	case SyncNodeType::SliceX:
+	case SyncNodeType::Delay:
+	case SyncNodeType::Inverse:
+	case SyncNodeType::Reverse:
+	case SyncNodeType::RepeatN:
+	case SyncNodeType::RepeatInfinite:
+	case SyncNodeType::Mirroring:
+		return 1;
+	case SyncNodeType::Add:
+	case SyncNodeType::Substract:
+	case SyncNodeType::Max:
+	case SyncNodeType::Min:
+	case SyncNodeType::And:
+	case SyncNodeType::Or:
+	case SyncNodeType::Concatenate:
+		return 2;
+	default:
+		return 0xFF;
+	}
+}
+
+bool SyncProgram::Compile(SyncFunction& root)
+{
+	_size = 0;
+	if (!Emit(root, 0, 0) || !Load(_size))
+	{
+		Clear();
+		return false;
+	}
+
+#if !SYNC_COMPACT_NODES
+	StarTime = root.StarTime;
+#endif
+	return true;
+}
+
+bool SyncProgram::Load(uint8_t size)
+{
+	if (size == 0 || size > _capacity)
+	{
+		Clear();
+		return false;
+	}
+
+	// Children must follow their parent, and the values must balance the stack
+	uint8_t depth = 0;
+	for (uint8_t i = size; i-- > 0;)
+	{
+		const SyncInstruction& instruction = _code[i];
+		const uint8_t arity = ArityOf(instruction.Code);
+		bool valid = arity != 0xFF && depth >= arity;
+		if (i > 0)
+		{
+			valid = valid && instruction.Parent < i && instruction.Child < ArityOf(_code[instruction.Parent].Code);
+			valid = valid && (instruction.Child != 0 || instruction.Parent == i - 1);
+		}
+		if (arity > 0 && valid && (instruction.Code == SyncNodeType::RepeatN || instruction.Code == SyncNodeType::RepeatInfinite)) valid = _code[i + 1].Interval > 0;
+		if (instruction.Code == SyncNodeType::SliceX && valid) valid = instruction.Interval > 0;
+		if (!valid)
+		{
+			Clear();
+			return false;
+		}
+		depth = depth - arity + 1;
+	}
+	if (depth != 1)
+	{
+		Clear();
+		return false;
+	}
+
+	for (uint8_t i = 0; i < size; i++) Derive(i);
+
+	_size = size;
+	Interval = _code[0].Interval;
+	return true;
+}
+
+// Parameters computed from the others, so they are not stored in patterns
+void SyncProgram::Derive(uint8_t index)
+{
+	SyncInstruction& instruction = _code[index];
+	switch (instruction.Code)
+	{
+	case SyncNodeType::Sin:
+	case SyncNodeType::Cos:
+		instruction.P[0].U = instruction.Interval > 0 ? SyncPhaseStep(instruction.Interval) : 0;
+		break;
+	case SyncNodeType::Speed:
+		// Same split as SyncTransformationSpeed, whole and 32 bits fraction of the factor
+		instruction.P[1].U = static_cast<unsigned long>(instruction.P[0].F);
+		instruction.P[2].U = static_cast<uint32_t>((instruction.P[0].F - instruction.P[1].U) * 4294967296.0f);
+		break;
+	case SyncNodeType::SliceX:
+		instruction.P[1].U = SyncTransformationSliceX::NormalizeOffset(instruction.P[0].L, instruction.Interval);
+		break;
+	case SyncNodeType::RepeatN:
+	case SyncNodeType::RepeatInfinite:
+		// Same split as SyncPeriod, with its shift in the flags and the current period in P[1] (start) and P[2] (index)
+		instruction.Flags = SyncPeriod::ShiftOf(_code[index + 1].Interval);
+		instruction.P[1].U = instruction.P[2].U = 0;
+		break;
+	default:
+		break;
+	}
+}
+
+bool SyncProgram::Emit(SyncFunction& node, uint8_t parent, uint8_t child)
+{
+	// Every instruction already runs once per evaluation, and on the time of the program
+	if (node.GetType() == SyncNodeType::Memo || node.GetType() == SyncNodeType::Root) return Emit(*node.GetChild(0), parent, child);
+
+	if (_size >= _capacity) return false;
+
+	const uint8_t index = _size++;
+	SyncInstruction& instruction = _code[index];
+	instruction.Code = node.GetType();
+	instruction.Parent = parent;
+	instruction.Child = child;
+	instruction.Flags = 0;
+	instruction.Interval = node.Interval;
+	instruction.P[0].U = instruction.P[1].U = instruction.P[2].U = 0;
+
+	switch (instruction.Code)
+	{
+	case SyncNodeType::Constant:
+		instruction.P[0].F = static_cast<SyncConstant&>(node).GetLevel();
+		break;
+	case SyncNodeType::Step:
+		instruction.P[0].U = static_cast<SyncStep&>(node).T0;
+		break;
+	case SyncNodeType::Triangular:
+		instruction.P[0].U = static_cast<SyncTriangular&>(node)._t0;
+		instruction.P[1].U = static_cast<SyncTriangular&>(node)._t1;
+		break;
+	case SyncNodeType::Trapezium:
+		instruction.P[0].U = static_cast<SyncTrapezium&>(node)._t0;
+		instruction.P[1].U = static_cast<SyncTrapezium&>(node)._t1;
+		instruction.P[2].U = static_cast<SyncTrapezium&>(node)._t2;
+		break;
+	case SyncNodeType::Sin:
+		instruction.Flags = static_cast<SyncSin&>(node).Fast ? SYNC_INSTRUCTION_FAST : 0;
+		break;
+	case SyncNodeType::Cos:
+		instruction.Flags = static_cast<SyncCos&>(node).Fast ? SYNC_INSTRUCTION_FAST : 0;
+		break;
+	case SyncNodeType::Speed:
+		instruction.P[0].F = static_cast<SyncTransformationSpeed&>(node).GetScaleFactor();
+		break;
+	case SyncNodeType::ScaleY:
+		instruction.P[0].F = static_cast<SyncTransformationScaleY&>(node).GetScaleFactor();
+		break;
+	case SyncNodeType::OffsetY:
+		instruction.P[0].F = static_cast<SyncTransformationOffsetY&>(node).GetOffset();
+		break;
+	case SyncNodeType::AffineY:
+		instruction.P[0].F = static_cast<SyncTransformationAffineY&>(node).GetScaleFactor();
+		instruction.P[1].F = static_cast<SyncTransformationAffineY&>(node).GetOffset();
+		break;
+	case SyncNodeType::SliceX:
+		instruction.P[0].L = static_cast<SyncTransformationSliceX&>(node).GetOffset();
+		break;
+	case SyncNodeType::Delay:
+		instruction.P[0].U = static_cast<SyncTransformationDelay&>(node).Delay;
+		break;
+	case SyncNodeType::RepeatN:
+		instruction.P[0].U = static_cast<SyncRepeatN&>(node).GetRepetitions();
+		break;
+	case SyncNodeType::Add:
+	case SyncNodeType::Substract:
+	case SyncNodeType::Max:
+	case SyncNodeType::Min:
+	case SyncNodeType::And:
+	case SyncNodeType::Or:
+		// Offsets between the start of the operation and the start of each operand (none for compact nodes)
+#if !SYNC_COMPACT_NODES
+		instruction.P[0].L = static_cast<int32_t>(node.StarTime - node.GetChild(0)->StarTime);
+		instruction.P[1].L = static_cast<int32_t>(node.StarTime - node.GetChild(1)->StarTime);
+#endif
+		break;
+	default:
+		if (ArityOf(instruction.Code) == 0xFF) return false;
+		break;
+	}
+
+	for (uint8_t i = 0; i < node.GetChildCount(); i++)
+	{
+		if (!Emit(*node.GetChild(i), index, i)) return false;
+	}
+	return true;
+}
+
+float SyncProgram::Calculate(unsigned long elapsedMillis)
+{
+	if (_size == 0) return 0.0;
+
+	_elapsed[0] = elapsedMillis;
+	for (uint8_t i = 1; i < _size; i++)
+	{
+		const SyncInstruction& instruction = _code[i];
+		_elapsed[i] = ElapsedOfChild(instruction.Parent, instruction.Child, _elapsed[instruction.Parent]);
+	}
+
+	// In reverse pre-order the values of the children are on the stack when their parent runs
+	uint8_t top = 0;
+	for (uint8_t i = _size; i-- > 0;)
+	{
+		const float value = Execute(i, _elapsed[i], top);
+		_stack[top++] = value;
+	}
+	return _stack[0];
+}
+
+unsigned long SyncProgram::ElapsedOfChild(uint8_t parent, uint8_t child, unsigned long elapsedMillis)
+{
+	SyncInstruction& instruction = _code[parent];
+	const unsigned long childInterval = _code[parent + 1].Interval;
+
+	switch (instruction.Code)
+	{
+	case SyncNodeType::Speed:
+		return elapsedMillis * instruction.P[1].U + static_cast<unsigned long>((static_cast<uint64_t>(elapsedMillis) * instruction.P[2].U) >> 32);
+	case SyncNodeType::SliceX:
+	{
+		const unsigned long elapsed = elapsedMillis + instruction.P[1].U;
+		return elapsed >= instruction.Interval ? elapsed - instruction.Interval : elapsed;
+	}
+	case SyncNodeType::Delay:
+		return elapsedMillis < instruction.P[0].U ? 0 : elapsedMillis - instruction.P[0].U;
+	case SyncNodeType::Reverse:
+		return elapsedMillis > instruction.Interval ? 0 : instruction.Interval - elapsedMillis;
+	case SyncNodeType::RepeatN:
+	case SyncNodeType::RepeatInfinite:
+	{
+		unsigned long start = instruction.P[1].U, index = instruction.P[2].U;
+		const unsigned long elapsed = SyncPeriod::Split(elapsedMillis, childInterval, instruction.Flags, start, index);
+		instruction.P[1].U = start;
+		instruction.P[2].U = index;
+		return elapsed;
+	}
+	case SyncNodeType::Mirroring:
+		return elapsedMillis < childInterval ? elapsedMillis : instruction.Interval - elapsedMillis;
+	case SyncNodeType::Concatenate:
+		return child == 0 || elapsedMillis <= childInterval ? elapsedMillis : elapsedMillis - childInterval;
+	case SyncNodeType::Add:
+	case SyncNodeType::Substract:
+	case SyncNodeType::Max:
+	case SyncNodeType::Min:
+	case SyncNodeType::And:
+	case SyncNodeType::Or:
+	{
+		const uint32_t elapsed = static_cast<uint32_t>(elapsedMillis + instruction.P[child].L);
+		return static_cast<int32_t>(elapsed) < 0 ? 0 : elapsed;
+	}
+	default:
+		return elapsedMillis;
+	}
+}
+
+float SyncProgram::Execute(uint8_t index, unsigned long elapsedMillis, uint8_t& top) const
+{
+	const SyncInstruction& instruction = _code[index];
+	const unsigned long interval = instruction.Interval;
+	const SyncParameter* p = instruction.P;
+
+	switch (instruction.Code)
+	{
+	case SyncNodeType::Zeros:
+		return 0.0;
+	case SyncNodeType::Constant:
+		return p[0].F;
+	case SyncNodeType::Step:
+		return elapsedMillis < p[0].U ? 1.0 : 0.0;
+	case SyncNodeType::Ramp:
+		if (elapsedMillis > interval) return 0.0;
+		return static_cast<float>(elapsedMillis) / interval;
+	case SyncNodeType::InverseRamp:
+		if (elapsedMillis > interval) return 0.0;
+		return 1.0f - static_cast<float>(elapsedMillis) / interval;
+	case SyncNodeType::Triangular:
+		if (elapsedMillis > interval) return 0.0;
+		if (elapsedMillis < p[0].U) return static_cast<float>(elapsedMillis) / p[0].U;
+		return 1.0f - (static_cast<float>(elapsedMillis) - p[0].U) / p[1].U;
+	case SyncNodeType::Trapezium:
+		if (elapsedMillis > interval) return 0.0;
+		if (elapsedMillis < p[0].U) return static_cast<float>(elapsedMillis) / p[0].U;
+		if (elapsedMillis < p[0].U + p[1].U) return 1.0f;
+		return 1.0f - (static_cast<float>(elapsedMillis) - p[1].U - p[0].U) / p[2].U;
+	case SyncNodeType::Sin:
+		if (elapsedMillis > interval) return 0.0;
+		if (instruction.Flags & SYNC_INSTRUCTION_FAST) return SyncFastSin(p[0].U * static_cast<uint32_t>(elapsedMillis));
+		return 0.5 * sin(2 * PI / interval * elapsedMillis) + 0.5;
+	case SyncNodeType::Cos:
+		if (elapsedMillis > interval) return 0.0;
+		if (instruction.Flags & SYNC_INSTRUCTION_FAST) return SyncFastSin(p[0].U * static_cast<uint32_t>(elapsedMillis) + 0x40000000UL);
+		return 0.5 * cos(2 * PI / interval * elapsedMillis) + 0.5;
+	default:
+		break;
+	}
+
+	const float value1 = _stack[--top];
+	switch (instruction.Code)
+	{
+	case SyncNodeType::Speed:
+	case SyncNodeType::ScaleY:
+		return p[0].F * value1;
+	case SyncNodeType::OffsetY:
+		return p[0].F + value1;
+	case SyncNodeType::AffineY:
+		return p[0].F * value1 + p[1].F;
+	case SyncNodeType::SliceX:
+	case SyncNodeType::Reverse:
+		return elapsedMillis > interval ? 0.0f : value1;
+	case SyncNodeType::Delay:
+		return elapsedMillis > interval || elapsedMillis < p[0].U ? 0.0f : value1;
+	case SyncNodeType::Inverse:
+		return 1.0f - value1;
+	case SyncNodeType::RepeatN:
+		return p[2].U >= p[0].U ? 0.0f : value1;
+	case SyncNodeType::RepeatInfinite:
+	case SyncNodeType::Mirroring:
+		return value1;
+	default:
+		break;
+	}
+
+	const float value2 = _stack[--top];
+	switch (instruction.Code)
+	{
+	case SyncNodeType::Add:
+		return value1 + value2;
+	case SyncNodeType::Substract:
+		return value1 - value2 < 0.0f ? 0.0f : value1 - value2;
+	case SyncNodeType::Max:
+		return value1 > value2 ? value1 : value2;
+	case SyncNodeType::Min:
+		return value1 < value2 ? value1 : value2;
+	case SyncNodeType::And:
+		return value1 > 0.0f && value2 > 0.0f ? 1.0f : 0.0f;
+	case SyncNodeType::Or:
+		return value1 > 0.0f || value2 > 0.0f ? 1.0f : 0.0f;
+	case SyncNodeType::Concatenate:
+		return elapsedMillis <= _code[index + 1].Interval ? value1 : value2;
+	default:
+		return 0.0;
+	}
+}
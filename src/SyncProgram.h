@@ -0,0 +1,106 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCPROGRAM_h
+#define _SYNCPROGRAM_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+
+// Sin and Cos use the table kernel
+#define SYNC_INSTRUCTION_FAST 0x01
+
+union SyncParameter
+{
+	uint32_t U;
+	int32_t L;
+	float F;
+};
+
+// One node of a flattened graph. Instructions are stored in pre-order, so the
+// children of a node follow it and every node can refer to its parent by index
+struct SyncInstruction
+{
+	SyncNodeType Code;
+	uint8_t Parent;
+	uint8_t Child;
+	uint8_t Flags;
+	uint32_t Interval;
+	SyncParameter P[3];
+};
+
+// Evaluates a graph flattened into an array of instructions, without virtual calls or pointers
+// Each evaluation runs two loops: top down to get the elapsed time of every node,
+// and bottom up to combine the values in a stack
+// The buffers are provided by the caller (or by SyncStaticProgram), so the footprint is fixed
+class SyncProgram : public SyncFunction
+{
+public:
+	SyncProgram(SyncInstruction* code, unsigned long* elapsed, float* stack, uint8_t capacity) : SyncFunction(0),
+		_code(code), _elapsed(elapsed), _stack(stack), _capacity(capacity) {}
+
+	// Flattens the graph of root, false if it does not fit or has nodes with state (Delta),
+	// external data (Wavetable) or of an unknown type
+	bool Compile(SyncFunction& root);
+
+	// Uses size instructions already written in the code buffer (e.g. loaded from a stream)
+	bool Load(uint8_t size);
+
+	void Clear() { _size = 0; Interval = 0; }
+
+	SyncNodeType GetType() const override { return SyncNodeType::Program; }
+
+	uint8_t GetSize() const { return _size; }
+	uint8_t GetCapacity() const { return _capacity; }
+	const SyncInstruction* GetInstructions() const { return _code; }
+	SyncInstruction* GetInstructions() { return _code; }
+
+	// Number of children of each instruction, 0xFF if it can not be part of a program
+	static uint8_t ArityOf(SyncNodeType code);
+
+	// RAM used for each node of the graph, including the evaluation buffers
+	static const size_t BytesPerNode = sizeof(SyncInstruction) + sizeof(unsigned long) + sizeof(float);
+
+	float Calculate(unsigned long elapsedMillis) override;
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis) out[i] = Calculate(startMillis);
+	}
+
+protected:
+	SyncInstruction* _code;
+	unsigned long* _elapsed;
+	float* _stack;
+	uint8_t _capacity;
+	uint8_t _size = 0;
+
+	bool Emit(SyncFunction& node, uint8_t parent, uint8_t child);
+	void Derive(uint8_t index);
+	unsigned long ElapsedOfChild(uint8_t parent, uint8_t child, unsigned long elapsedMillis);
+	float Execute(uint8_t index, unsigned long elapsedMillis, uint8_t& top) const;
+};
+
+template<uint8_t N>
+class SyncStaticProgram : public SyncProgram
+{
+public:
+	SyncStaticProgram() : SyncProgram(_instructions, _elapsedBuffer, _stackBuffer, N) {}
+
+	SyncStaticProgram(SyncFunction& root) : SyncStaticProgram() { Compile(root); }
+
+private:
+	SyncInstruction _instructions[N];
+	unsigned long _elapsedBuffer[N];
+	float _stackBuffer[N];
+};
+#endif
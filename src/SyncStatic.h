@@ -0,0 +1,289 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCSTATIC_h
+#define _SYNCSTATIC_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+#include "SyncMath.h"
+
+// Compile time waveforms. A pattern is a type, e.g.
+//   SyncStatic::Repeat<SyncStatic::Concat<SyncStatic::Ramp<150>, SyncStatic::Constant<300, 1>>, 3>
+// and is evaluated by a single inlined function, without heap or virtual calls
+// Float parameters are given as a fraction Num / Den
+namespace SyncStatic
+{
+	template<unsigned long T>
+	struct Zeros
+	{
+		static constexpr unsigned long Interval = T;
+		static float Calculate(unsigned long elapsedMillis) { return 0.0; }
+	};
+
+	// Clamped to 0.0 - 1.0, as SyncConstant
+	template<unsigned long T, long Num, long Den = 1>
+	struct Constant
+	{
+		static constexpr unsigned long Interval = T;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			return static_cast<float>(Num) / Den > 1.0f ? 1.0f : static_cast<float>(Num) / Den < 0.0f ? 0.0f : static_cast<float>(Num) / Den;
+		}
+	};
+
+	template<unsigned long T0, unsigned long T>
+	struct Step
+	{
+		static constexpr unsigned long Interval = T;
+		static float Calculate(unsigned long elapsedMillis) { return elapsedMillis < T0 ? 1.0 : 0.0; }
+	};
+
+	template<unsigned long T>
+	struct Ramp
+	{
+		static constexpr unsigned long Interval = T;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > T) return 0.0;
+			return static_cast<float>(elapsedMillis) / T;
+		}
+	};
+
+	template<unsigned long T>
+	struct InverseRamp
+	{
+		static constexpr unsigned long Interval = T;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > T) return 0.0;
+			return 1.0f - static_cast<float>(elapsedMillis) / T;
+		}
+	};
+
+	template<unsigned long T0, unsigned long T1>
+	struct Triangular
+	{
+		static constexpr unsigned long Interval = T0 + T1;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > T0 + T1) return 0.0;
+			if (elapsedMillis < T0) return static_cast<float>(elapsedMillis) / T0;
+			return 1.0f - (static_cast<float>(elapsedMillis) - T0) / T1;
+		}
+	};
+
+	template<unsigned long T0, unsigned long T1, unsigned long T2>
+	struct Trapezium
+	{
+		static constexpr unsigned long Interval = T0 + T1 + T2;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > T0 + T1 + T2) return 0.0;
+			if (elapsedMillis < T0) return static_cast<float>(elapsedMillis) / T0;
+			if (elapsedMillis < T0 + T1) return 1.0f;
+			return 1.0f - (static_cast<float>(elapsedMillis) - T1 - T0) / T2;
+		}
+	};
+
+	// Sin and Cos always use the table kernel of SyncMath.h
+	template<unsigned long T>
+	struct Sin
+	{
+		static constexpr unsigned long Interval = T;
+		static constexpr uint32_t PhaseStep = SyncPhaseStep(T);
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > T) return 0.0;
+			return SyncFastSin(PhaseStep * static_cast<uint32_t>(elapsedMillis));
+		}
+	};
+
+	template<unsigned long T>
+	struct Cos
+	{
+		static constexpr unsigned long Interval = T;
+		static constexpr uint32_t PhaseStep = SyncPhaseStep(T);
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > T) return 0.0;
+			return SyncFastSin(PhaseStep * static_cast<uint32_t>(elapsedMillis) + 0x40000000UL);
+		}
+	};
+
+	template<typename A, long Num, long Den = 1>
+	struct Speed
+	{
+		static constexpr unsigned long Interval = A::Interval * Den / Num;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			// 64 bits product, so long runs do not overflow
+			return static_cast<float>(Num) / Den * A::Calculate(static_cast<unsigned long>(static_cast<uint64_t>(elapsedMillis) * Num / Den));
+		}
+	};
+
+	template<typename A, long Num, long Den = 1>
+	struct ScaleY
+	{
+		static constexpr unsigned long Interval = A::Interval;
+		static float Calculate(unsigned long elapsedMillis) { return static_cast<float>(Num) / Den * A::Calculate(elapsedMillis); }
+	};
+
+	template<typename A, long Num, long Den = 1>
+	struct OffsetY
+	{
+		static constexpr unsigned long Interval = A::Interval;
+		static float Calculate(unsigned long elapsedMillis) { return static_cast<float>(Num) / Den + A::Calculate(elapsedMillis); }
+	};
+
+	template<typename A, long Offset>
+	struct SliceX
+	{
+		static constexpr unsigned long Interval = A::Interval;
+		static constexpr unsigned long Shift = SyncSliceShift(Offset, A::Interval);
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			// Same wrap as SyncTransformationSliceX, negative offsets shift backwards
+			if (elapsedMillis > A::Interval) return 0.0;
+			const unsigned long elapsed = elapsedMillis + Shift;
+			return A::Calculate(elapsed >= A::Interval ? elapsed - A::Interval : elapsed);
+		}
+	};
+
+	template<typename A, unsigned long D>
+	struct Delay
+	{
+		static constexpr unsigned long Interval = A::Interval + D;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > A::Interval + D || elapsedMillis < D) return 0.0;
+			return A::Calculate(elapsedMillis - D);
+		}
+	};
+
+	template<typename A>
+	struct Inverse
+	{
+		static constexpr unsigned long Interval = A::Interval;
+		static float Calculate(unsigned long elapsedMillis) { return 1.0f - A::Calculate(elapsedMillis); }
+	};
+
+	template<typename A>
+	struct Reverse
+	{
+		static constexpr unsigned long Interval = A::Interval;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis > A::Interval) return 0.0;
+			return A::Calculate(A::Interval - elapsedMillis);
+		}
+	};
+
+	// Repetitions = 0 repeats forever
+	template<typename A, unsigned int Repetitions = 0>
+	struct Repeat
+	{
+		static_assert(A::Interval > 0, "Repeat needs a function with an Interval greater than 0");
+		static constexpr unsigned long Interval = A::Interval * (Repetitions == 0 ? 1 : Repetitions);
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (Repetitions != 0 && elapsedMillis / A::Interval >= Repetitions) return 0.0;
+			return A::Calculate(elapsedMillis % A::Interval);
+		}
+	};
+
+	template<typename A>
+	struct Mirroring
+	{
+		static constexpr unsigned long Interval = A::Interval * 2;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			return A::Calculate(elapsedMillis < A::Interval ? elapsedMillis : A::Interval * 2 - elapsedMillis);
+		}
+	};
+
+	// Concat<A, B, C...> plays each function after the previous one, as operator +
+	template<typename A, typename B, typename... Rest>
+	struct Concat : Concat<A, Concat<B, Rest...>> {};
+
+	template<typename A, typename B>
+	struct Concat<A, B>
+	{
+		static constexpr unsigned long Interval = A::Interval + B::Interval;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			if (elapsedMillis <= A::Interval) return A::Calculate(elapsedMillis);
+			return B::Calculate(elapsedMillis - A::Interval);
+		}
+	};
+
+	template<typename A, typename B>
+	struct Add
+	{
+		static constexpr unsigned long Interval = A::Interval > B::Interval ? A::Interval : B::Interval;
+		static float Calculate(unsigned long elapsedMillis) { return A::Calculate(elapsedMillis) + B::Calculate(elapsedMillis); }
+	};
+
+	template<typename A, typename B>
+	struct Substract
+	{
+		static constexpr unsigned long Interval = A::Interval > B::Interval ? A::Interval : B::Interval;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			const float rst = A::Calculate(elapsedMillis) - B::Calculate(elapsedMillis);
+			return rst < 0.0f ? 0.0f : rst;
+		}
+	};
+
+	template<typename A, typename B>
+	struct Max
+	{
+		static constexpr unsigned long Interval = A::Interval > B::Interval ? A::Interval : B::Interval;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			const float value1 = A::Calculate(elapsedMillis);
+			const float value2 = B::Calculate(elapsedMillis);
+			return value1 > value2 ? value1 : value2;
+		}
+	};
+
+	template<typename A, typename B>
+	struct Min
+	{
+		static constexpr unsigned long Interval = A::Interval > B::Interval ? A::Interval : B::Interval;
+		static float Calculate(unsigned long elapsedMillis)
+		{
+			const float value1 = A::Calculate(elapsedMillis);
+			const float value2 = B::Calculate(elapsedMillis);
+			return value1 < value2 ? value1 : value2;
+		}
+	};
+}
+
+// Wraps a compile time pattern as a regular SyncFunction, so it can be mixed with the runtime API
+template<typename TPattern>
+class SyncStaticFunction : public SyncFunction
+{
+public:
+	SyncStaticFunction() : SyncFunction(TPattern::Interval) {}
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return TPattern::Calculate(elapsedMillis);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis) out[i] = TPattern::Calculate(startMillis);
+	}
+};
+#endif
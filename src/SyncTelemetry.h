@@ -0,0 +1,228 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCTELEMETRY_h
+#define _SYNCTELEMETRY_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+
+// Binary telemetry frame:
+//   'S' 'T' version sequence channels bits samples, time (4 bytes), period (4 bytes), values, then the sum of all the previous bytes
+// Integers are little endian. time is the SyncClock time of the first sample, the next ones are period ticks apart
+// Values are sample after sample, channel after channel, codes of bits (8 or 16) as in SyncQ16ToCode()
+// The first sample of each channel is absolute, the next ones are the signed byte difference to the previous
+// sample of the channel, or SYNC_TELEMETRY_ESCAPE followed by the absolute code (1 or 2 bytes) if it does not fit
+// sequence increases by one per frame, so the receiver can tell lost frames. extras/SyncTelemetry.py decodes it
+#define SYNC_TELEMETRY_VERSION 1
+#define SYNC_TELEMETRY_ESCAPE 0x80
+
+// Disables the interrupts while in scope, then restores their previous state instead of enabling them,
+// so it can also be used in an ISR or where the interrupts were already disabled
+class SyncInterruptGuard
+{
+public:
+#if defined(SREG)
+	SyncInterruptGuard() : _state(SREG) { cli(); }
+	~SyncInterruptGuard() { SREG = _state; }
+
+private:
+	uint8_t _state;
+#elif defined(__arm__) && defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+	SyncInterruptGuard() { __asm__ volatile("mrs %0, primask\n\tcpsid i" : "=r"(_state) : : "memory"); }
+	~SyncInterruptGuard() { __asm__ volatile("msr primask, %0" : : "r"(_state) : "memory"); }
+
+private:
+	uint32_t _state;
+#else
+	// Without a known way to read the state (e.g. ESP boards), they are enabled again
+	SyncInterruptGuard() { noInterrupts(); }
+	~SyncInterruptGuard() { interrupts(); }
+#endif
+};
+
+// Samples N functions every period into a ring of Capacity samples, and sends them in frames to any Print
+// Sample() and Send() can be called from an ISR and the main loop, respectively: each one only writes its
+// own single byte index, as in SyncTriggerQueue. Capacity must be a power of two lower or equal to 128
+// Functions are evaluated again for the telemetry, so do not attach ones with state (e.g. SyncDelta)
+template<uint8_t N, uint8_t Capacity = 32>
+class SyncTelemetry
+{
+	static_assert(Capacity >= 2 && Capacity <= 128 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two up to 128");
+
+public:
+	// A period of 0 would take the same sample forever, it is taken as 1 tick
+	SyncTelemetry(Print& out, unsigned long period, uint8_t bits = 8, uint8_t frameSamples = Capacity / 2)
+		: Period(period > 0 ? period : 1), Bits(bits > 8 ? 16 : 8), FrameSamples(frameSamples < Capacity ? frameSamples : Capacity - 1), _out(out)
+	{
+		for (uint8_t channel = 0; channel < N; channel++) _functions[channel] = nullptr;
+	}
+
+	const unsigned long Period;
+	const uint8_t Bits;
+	const uint8_t FrameSamples;
+
+	void Attach(uint8_t channel, SyncFunction& function)
+	{
+		_functions[channel] = &function;
+	}
+
+	void Detach(uint8_t channel)
+	{
+		_functions[channel] = nullptr;
+	}
+
+	// Takes every sample due until now, at its exact time, so a late call does not change the trace
+	// Samples that do not fit in the ring are dropped, and the next frame starts after the gap
+	uint8_t Sample()
+	{
+		return Sample(SyncClock::Now());
+	}
+
+	uint8_t Sample(unsigned long now)
+	{
+		if (!_started)
+		{
+			_started = true;
+			_next = now;
+		}
+
+		uint8_t taken = 0;
+		// 32 bits differences, as SyncClock::Elapsed, whatever the size of unsigned long
+		while (SyncClock::Elapsed(_next, now) <= 0x7FFFFFFFUL)
+		{
+			const uint8_t head = _head;
+			const uint8_t next = (head + 1) & (Capacity - 1);
+			if (next == _tail)
+			{
+				// Skips all the samples due, without evaluating them
+				const unsigned long skipped = SyncClock::Elapsed(_next, now) / Period + 1;
+				_dropped += skipped;
+				_next += skipped * Period;
+				break;
+			}
+
+			_times[head] = _next;
+			for (uint8_t channel = 0; channel < N; channel++)
+			{
+				SyncFunction* function = _functions[channel];
+				const int32_t value = function == nullptr ? 0 : function->GetValueQ16(SyncClock::Elapsed(function->GetStartTime(), _next));
+				_codes[head][channel] = SyncQ16ToCode(value, Bits);
+			}
+			_head = next;
+			_next += Period;
+			taken++;
+		}
+		return taken;
+	}
+
+	// Sends a frame once FrameSamples are ready (or any sample with flush), returns true if it sent one
+	// Frames stop at gaps of dropped samples, so each one has a single time base
+	bool Send(bool flush = false)
+	{
+		const uint8_t tail = _tail;
+		const uint8_t available = (_head - tail) & (Capacity - 1);
+		if (available == 0 || (!flush && available < FrameSamples)) return false;
+
+		uint8_t count = 1;
+		const uint8_t limit = available < FrameSamples ? available : FrameSamples;
+		while (count < limit && SyncClock::Elapsed(_times[(tail + count - 1) & (Capacity - 1)], _times[(tail + count) & (Capacity - 1)]) == Period) count++;
+
+		_checksum = 0;
+		Write('S');
+		Write('T');
+		Write(SYNC_TELEMETRY_VERSION);
+		Write(_sequence++);
+		Write(N);
+		Write(Bits);
+		Write(count);
+		WriteInteger(_times[tail], 4);
+		WriteInteger(Period, 4);
+
+		const uint8_t size = Bits / 8;
+		for (uint8_t sample = 0; sample < count; sample++)
+		{
+			const uint8_t index = (tail + sample) & (Capacity - 1);
+			const uint8_t previous = (index - 1) & (Capacity - 1);
+			for (uint8_t channel = 0; channel < N; channel++)
+			{
+				const uint16_t code = _codes[index][channel];
+				const int32_t delta = static_cast<int32_t>(code) - _codes[previous][channel];
+				if (sample > 0 && delta > -128 && delta < 128)
+				{
+					Write(static_cast<uint8_t>(delta));
+					continue;
+				}
+
+				if (sample > 0) Write(SYNC_TELEMETRY_ESCAPE);
+				WriteInteger(code, size);
+			}
+		}
+		Write(_checksum);
+
+		_tail = (tail + count) & (Capacity - 1);
+		_frames++;
+		return true;
+	}
+
+	// Samples lost because the ring was full, i.e. Send() was not called often enough
+	// Read with interrupts disabled, as Sample() may update it from an ISR halfway through the read on 8 bits boards
+	unsigned long GetDroppedSamples() const
+	{
+		SyncInterruptGuard guard;
+		return _dropped;
+	}
+
+	unsigned long GetFrames() const { return _frames; }
+	unsigned long GetBytes() const { return _bytes; }
+
+	void ResetStatistics()
+	{
+		{
+			SyncInterruptGuard guard;
+			_dropped = 0;
+		}
+		_frames = 0;
+		_bytes = 0;
+	}
+
+private:
+	Print& _out;
+	SyncFunction* _functions[N];
+
+	unsigned long _times[Capacity];
+	uint16_t _codes[Capacity][N];
+	volatile uint8_t _head = 0;
+	volatile uint8_t _tail = 0;
+
+	bool _started = false;
+	unsigned long _next = 0;
+	uint8_t _sequence = 0;
+	uint8_t _checksum = 0;
+
+	volatile unsigned long _dropped = 0;
+	unsigned long _frames = 0;
+	unsigned long _bytes = 0;
+
+	void Write(uint8_t value)
+	{
+		_out.write(value);
+		_checksum += value;
+		_bytes++;
+	}
+
+	void WriteInteger(uint32_t value, uint8_t size)
+	{
+		for (uint8_t i = 0; i < size; i++) Write(static_cast<uint8_t>(value >> (8 * i)));
+	}
+};
+#endif
@@ -1,182 +1,798 @@
-/***************************************************
-Copyright (c) 2019 Luis Llamas
-(www.luisllamas.es)
-Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
-Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
- ****************************************************/
-
-#ifndef _SYNCTRANSFORMATION_h
-#define _SYNCTRANSFORMATION_h
-
-#if defined(ARDUINO) && ARDUINO >= 100
-	#include "Arduino.h"
-#else
-	#include "WProgram.h"
-#endif
-
-class SyncTransformationSpeed : public SyncTransformation
-{
-public:
-	SyncTransformationSpeed(SyncFunction& op1, float scaleFactor) : SyncTransformation(op1), ScaleFactor(scaleFactor) { Interval = static_cast<unsigned long>(op1.Interval / scaleFactor); }
-
-	float ScaleFactor;
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return ScaleFactor * _op1.GetValue(static_cast<unsigned long>(elapsedMillis * ScaleFactor));
-	}
-};
-
-class SyncTransformationScaleY : public SyncTransformation
-{
-public:
-	SyncTransformationScaleY(SyncFunction& op1, float scaleFactor) : SyncTransformation(op1), ScaleFactor(scaleFactor) {}
-
-	float ScaleFactor;
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return ScaleFactor * _op1.GetValue(elapsedMillis);
-	}
-};
-
-class SyncTransformationOffsetY : public SyncTransformation
-{
-public:
-	SyncTransformationOffsetY(SyncFunction& op1, float offset) : SyncTransformation(op1), Offset(offset) {}
-
-	float Offset;
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return Offset + _op1.GetValue(elapsedMillis);
-	}
-};
-
-class SyncTransformationSliceX : public SyncTransformation
-{
-public:
-	SyncTransformationSliceX(SyncFunction& op1, long offsetX) : SyncTransformation(op1), Offset(offsetX) {}
-
-	long  Offset;
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-		auto elapsed = elapsedMillis + Offset;
-		elapsed = elapsed % Interval;
-		return _op1.GetValue(elapsed);
-	}
-};
-
-class SyncTransformationDelay : public SyncTransformation
-{
-public:
-	SyncTransformationDelay(SyncFunction& op1, unsigned long delay) : SyncTransformation(op1), Delay(delay) { Interval = op1.Interval + delay; }
-
-	unsigned long Delay;
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-
-		if (elapsedMillis < Delay) return 0.0;
-		return _op1.GetValue(elapsedMillis - Delay);
-	}
-};
-
-
-class SyncTransformationInverse : public SyncTransformation
-{
-public:
-	SyncTransformationInverse(SyncFunction& op1) : SyncTransformation(op1) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		return 1.0 - _op1.GetValue(elapsedMillis);
-	}
-};
-
-class SyncTransformationReverse : public SyncTransformation
-{
-public:
-	SyncTransformationReverse(SyncFunction& op1) : SyncTransformation(op1) {}
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis > Interval) return 0.0;
-
-		return _op1.GetValue(Interval - elapsedMillis);
-	}
-};
-
-
-class SyncRepeatN : public SyncTransformation
-{
-public:
-	SyncRepeatN(SyncFunction& op1, unsigned int repetitions) : SyncTransformation(op1), _repetitions(repetitions) { Interval = op1.Interval * repetitions; }
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (_repetitions == 0) return 0.0;
-
-		const auto currentRepetition = elapsedMillis / _op1.Interval;
-		if(currentRepetition != _lastRepetion)
-		{
-			_lastRepetion = currentRepetition;
-			_op1.Reset();
-		}
-		if (currentRepetition >= _repetitions) return 0.0;
-		return _op1.GetValue(elapsedMillis % _op1.Interval);
-	}
-
-
-protected:
-	uint8_t _repetitions;
-	unsigned int _lastRepetion = 0;
-};
-
-class SyncRepeatInfinite : public SyncTransformation
-{
-public:
-	SyncRepeatInfinite(SyncFunction& op1) : SyncTransformation(op1) { Interval = op1.Interval; }
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		const auto currentRepetition = elapsedMillis / _op1.Interval;
-		if (currentRepetition != _lastRepetion)
-		{
-			_lastRepetion = currentRepetition;
-			_op1.Reset();
-		}
-
-		return _op1.GetValue(elapsedMillis % _op1.Interval);
-	}
-
-protected:
-	unsigned int _lastRepetion = 0;
-};
-
-class SyncMirroring : public SyncFunction
-{
-public:
-	SyncMirroring(SyncFunction& op1) : SyncFunction(op1.Interval * 2), _op1(op1) { }
-
-	float Calculate(unsigned long elapsedMillis) override
-	{
-		if (elapsedMillis < _op1.Interval)
-		{
-			return _op1.GetValue(elapsedMillis);
-		}
-		else
-		{
-			return _op1.GetValue(Interval - elapsedMillis);
-		}
-	}
-
-protected:
-	SyncFunction& _op1;
-};
-
-#endif
-
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCTRANSFORMATION_h
+#define _SYNCTRANSFORMATION_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+class SyncTransformationSpeed : public SyncTransformation
+{
+public:
+	SyncTransformationSpeed(SyncFunction& op1, float scaleFactor) : SyncTransformation(op1)
+	{
+		SetScaleFactor(scaleFactor);
+	}
+
+	float GetScaleFactor() const { return _scaleFactor; }
+
+	// Also scales the Interval of the node
+	void SetScaleFactor(float scaleFactor)
+	{
+		_scaleFactor = scaleFactor;
+		_scaleFactorQ16 = SyncToQ16(scaleFactor);
+		_whole = static_cast<unsigned long>(scaleFactor);
+		_fraction = static_cast<uint32_t>((scaleFactor - _whole) * 4294967296.0f);
+		Interval = static_cast<unsigned long>(_op1->Interval / scaleFactor);
+	}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Speed; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return _scaleFactor * _op1->GetValue(ScaleTime(elapsedMillis));
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		// Scaled sample times only stay evenly spaced when the scaled step is integral
+		if (static_cast<uint32_t>(stepMillis * _fraction) != 0)
+		{
+			SyncFunction::CalculateBlock(out, n, startMillis, stepMillis);
+			return;
+		}
+
+		_op1->Render(out, n, ScaleTime(startMillis), ScaleTime(stepMillis));
+		for (size_t i = 0; i < n; i++) out[i] *= _scaleFactor;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return SyncMulQ16(_scaleFactorQ16, _op1->GetValueQ16(ScaleTime(elapsedMillis)));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		const unsigned long change = _op1->GetNextChange(ScaleTime(elapsedMillis));
+		if (change == SYNC_NEVER) return SYNC_NEVER;
+
+		// First time whose scaled value reaches the change of the operand
+		unsigned long next = static_cast<unsigned long>(change / _scaleFactor);
+		while (next > 0 && ScaleTime(next - 1) >= change) next--;
+		while (ScaleTime(next) < change) next++;
+		return next > elapsedMillis ? next : elapsedMillis + 1;
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(ScaleTime(elapsedMillis));
+	}
+
+protected:
+	float _scaleFactor;
+	int32_t _scaleFactorQ16;
+
+	// Factor split as integer and 32 bits fraction, so the scaled time is exact for any elapsed time
+	unsigned long _whole;
+	uint32_t _fraction;
+
+	unsigned long ScaleTime(unsigned long elapsedMillis) const
+	{
+		return elapsedMillis * _whole + static_cast<unsigned long>((static_cast<uint64_t>(elapsedMillis) * _fraction) >> 32);
+	}
+};
+
+class SyncTransformationScaleY : public SyncTransformation
+{
+public:
+	SyncTransformationScaleY(SyncFunction& op1, float scaleFactor) : SyncTransformation(op1)
+	{
+		SetScaleFactor(scaleFactor);
+	}
+
+	float GetScaleFactor() const { return _scaleFactor; }
+
+	void SetScaleFactor(float scaleFactor)
+	{
+		_scaleFactor = scaleFactor;
+		_scaleFactorQ16 = SyncToQ16(scaleFactor);
+	}
+
+	SyncNodeType GetType() const override { return SyncNodeType::ScaleY; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return _scaleFactor * _op1->GetValue(elapsedMillis);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		_op1->Render(out, n, startMillis, stepMillis);
+		for (size_t i = 0; i < n; i++) out[i] *= _scaleFactor;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return SyncMulQ16(_scaleFactorQ16, _op1->GetValueQ16(elapsedMillis));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _op1->GetNextChange(elapsedMillis);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(elapsedMillis);
+	}
+
+protected:
+	float _scaleFactor;
+	int32_t _scaleFactorQ16;
+};
+
+class SyncTransformationOffsetY : public SyncTransformation
+{
+public:
+	SyncTransformationOffsetY(SyncFunction& op1, float offset) : SyncTransformation(op1)
+	{
+		SetOffset(offset);
+	}
+
+	float GetOffset() const { return _offset; }
+
+	void SetOffset(float offset)
+	{
+		_offset = offset;
+		_offsetQ16 = SyncToQ16(offset);
+	}
+
+	SyncNodeType GetType() const override { return SyncNodeType::OffsetY; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return _offset + _op1->GetValue(elapsedMillis);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		_op1->Render(out, n, startMillis, stepMillis);
+		for (size_t i = 0; i < n; i++) out[i] += _offset;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return _offsetQ16 + _op1->GetValueQ16(elapsedMillis);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _op1->GetNextChange(elapsedMillis);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(elapsedMillis);
+	}
+
+protected:
+	float _offset;
+	int32_t _offsetQ16;
+};
+
+// Scale * value + Offset, the result of fusing ScaleY, OffsetY and Inverse chains (see SyncOptimize)
+class SyncTransformationAffineY : public SyncTransformation
+{
+public:
+	SyncTransformationAffineY(SyncFunction& op1, float scaleFactor, float offset) : SyncTransformation(op1)
+	{
+		SetScaleFactor(scaleFactor);
+		SetOffset(offset);
+	}
+
+	float GetScaleFactor() const { return _scaleFactor; }
+	float GetOffset() const { return _offset; }
+
+	void SetScaleFactor(float scaleFactor)
+	{
+		_scaleFactor = scaleFactor;
+		_scaleFactorQ16 = SyncToQ16(scaleFactor);
+	}
+
+	void SetOffset(float offset)
+	{
+		_offset = offset;
+		_offsetQ16 = SyncToQ16(offset);
+	}
+
+	SyncNodeType GetType() const override { return SyncNodeType::AffineY; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return _scaleFactor * _op1->GetValue(elapsedMillis) + _offset;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		_op1->Render(out, n, startMillis, stepMillis);
+		for (size_t i = 0; i < n; i++) out[i] = _scaleFactor * out[i] + _offset;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return SyncMulQ16(_scaleFactorQ16, _op1->GetValueQ16(elapsedMillis)) + _offsetQ16;
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _op1->GetNextChange(elapsedMillis);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(elapsedMillis);
+	}
+
+protected:
+	float _scaleFactor;
+	float _offset;
+	int32_t _scaleFactorQ16;
+	int32_t _offsetQ16;
+};
+
+class SyncTransformationSliceX : public SyncTransformation
+{
+public:
+	SyncTransformationSliceX(SyncFunction& op1, long offsetX) : SyncTransformation(op1)
+	{
+		SetOffset(offsetX);
+	}
+
+	long GetOffset() const { return _offsetX; }
+
+	void SetOffset(long offsetX)
+	{
+		_offsetX = offsetX;
+		_offset = NormalizeOffset(offsetX, Interval);
+	}
+
+	// Offset as a positive shift lower than interval, so wrapping needs a subtraction instead of a modulo
+	static unsigned long NormalizeOffset(long offset, unsigned long interval)
+	{
+		return SyncSliceShift(offset, interval);
+	}
+
+	SyncNodeType GetType() const override { return SyncNodeType::SliceX; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+		return _op1->GetValue(Wrap(elapsedMillis));
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		const size_t active = CountBefore(n, startMillis, stepMillis, Interval + 1);
+		size_t done = 0;
+		while (done < active)
+		{
+			// Contiguous run of samples until the sliced time wraps around
+			const unsigned long elapsed = Wrap(startMillis + done * stepMillis);
+			size_t count = CountBefore(active - done, elapsed, stepMillis, Interval);
+			if (count == 0) count = 1;
+			_op1->Render(out + done, count, elapsed, stepMillis);
+			done += count;
+		}
+		for (; done < n; done++) out[done] = 0.0;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		return _op1->GetValueQ16(Wrap(elapsedMillis));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return SYNC_NEVER;
+
+		// The sliced time wraps around, and the output drops to 0 after Interval
+		const unsigned long elapsed = Wrap(elapsedMillis);
+		const unsigned long change = ShiftChange(_op1->GetNextChange(elapsed), elapsedMillis - elapsed);
+		const unsigned long wrap = elapsedMillis + Interval - elapsed;
+		return min(min(change, wrap), Interval + 1UL);
+	}
+
+protected:
+	long _offsetX;
+	SyncInterval _offset;
+
+	// Only valid for elapsedMillis <= Interval
+	unsigned long Wrap(unsigned long elapsedMillis) const
+	{
+		const unsigned long elapsed = elapsedMillis + _offset;
+		return elapsed >= Interval ? elapsed - Interval : elapsed;
+	}
+};
+
+class SyncTransformationDelay : public SyncTransformation
+{
+public:
+	SyncTransformationDelay(SyncFunction& op1, unsigned long delay) : SyncTransformation(op1), Delay(delay) { Interval = op1.Interval + delay; }
+
+	SyncInterval Delay;
+
+	SyncNodeType GetType() const override { return SyncNodeType::Delay; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+
+		if (elapsedMillis < Delay) return 0.0;
+		return _op1->GetValue(elapsedMillis - Delay);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		const size_t delayed = CountBefore(n, startMillis, stepMillis, Delay);
+		const size_t active = CountBefore(n, startMillis, stepMillis, Interval + 1);
+		for (size_t i = 0; i < delayed; i++) out[i] = 0.0;
+		if (active > delayed) _op1->Render(out + delayed, active - delayed, startMillis + delayed * stepMillis - Delay, stepMillis);
+		for (size_t i = active > delayed ? active : delayed; i < n; i++) out[i] = 0.0;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval || elapsedMillis < Delay) return 0;
+		return _op1->GetValueQ16(elapsedMillis - Delay);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return SYNC_NEVER;
+		if (elapsedMillis < Delay) return Delay;
+		const unsigned long change = ShiftChange(_op1->GetNextChange(elapsedMillis - Delay), Delay);
+		return min(change, Interval + 1UL);
+	}
+};
+
+
+class SyncTransformationInverse : public SyncTransformation
+{
+public:
+	SyncTransformationInverse(SyncFunction& op1) : SyncTransformation(op1) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Inverse; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return 1.0 - _op1->GetValue(elapsedMillis);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		_op1->Render(out, n, startMillis, stepMillis);
+		for (size_t i = 0; i < n; i++) out[i] = 1.0 - out[i];
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return SYNC_Q16_ONE - _op1->GetValueQ16(elapsedMillis);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _op1->GetNextChange(elapsedMillis);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(elapsedMillis);
+	}
+};
+
+class SyncTransformationReverse : public SyncTransformation
+{
+public:
+	SyncTransformationReverse(SyncFunction& op1) : SyncTransformation(op1) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Reverse; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0.0;
+
+		return _op1->GetValue(Interval - elapsedMillis);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		// Render the mirrored times in increasing order and flip the result
+		const size_t active = CountBefore(n, startMillis, stepMillis, Interval + 1);
+		if (active > 0)
+		{
+			_op1->Render(out, active, Interval - (startMillis + (active - 1) * stepMillis), stepMillis);
+			ReverseBlock(out, active);
+		}
+		for (size_t i = active; i < n; i++) out[i] = 0.0;
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval) return 0;
+		return _op1->GetValueQ16(Interval - elapsedMillis);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+};
+
+
+class SyncRepeatN : public SyncTransformation
+{
+public:
+	SyncRepeatN(SyncFunction& op1, unsigned int repetitions) : SyncTransformation(op1), _repetitions(repetitions) { Interval = op1.Interval * repetitions; }
+
+	SyncNodeType GetType() const override { return SyncNodeType::RepeatN; }
+
+	uint8_t GetRepetitions() const { return _repetitions; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		unsigned long local;
+		if (!EnterRepetition(elapsedMillis, local)) return 0.0;
+		return _op1->GetValue(local);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		unsigned long local;
+		if (!EnterRepetition(elapsedMillis, local)) return 0;
+		return _op1->GetValueQ16(local);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		if (_repetitions == 0) return SYNC_NEVER;
+		const unsigned long elapsed = _period.Split(elapsedMillis, _op1->Interval);
+		if (_period.Index >= _repetitions) return SYNC_NEVER;
+
+		// The operand restarts at the end of each repetition
+		const unsigned long change = ShiftChange(_op1->GetNextChange(elapsed), elapsedMillis - elapsed);
+		const unsigned long nextRepetition = elapsedMillis - elapsed + _op1->Interval;
+		return min(change, nextRepetition);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		size_t done = 0;
+		while (done < n)
+		{
+			unsigned long local;
+			if (!EnterRepetition(startMillis + done * stepMillis, local)) break;
+
+			size_t count = CountBefore(n - done, local, stepMillis, _op1->Interval);
+			if (count == 0) count = 1;
+			_op1->Render(out + done, count, local, stepMillis);
+			done += count;
+		}
+		for (; done < n; done++) out[done] = 0.0;
+	}
+
+
+protected:
+	uint8_t _repetitions;
+	unsigned long _lastRepetion = 0;
+	SyncPeriod _period;
+
+	// Resets the operand when the repetition changes, false once all of them are done
+	bool EnterRepetition(unsigned long elapsedMillis, unsigned long& local)
+	{
+		if (_repetitions == 0) return false;
+
+		local = _period.Split(elapsedMillis, _op1->Interval);
+		if (_period.Index != _lastRepetion)
+		{
+			_lastRepetion = _period.Index;
+			_op1->Reset();
+		}
+		return _period.Index < _repetitions;
+	}
+};
+
+class SyncRepeatInfinite : public SyncTransformation
+{
+public:
+	SyncRepeatInfinite(SyncFunction& op1) : SyncTransformation(op1) { Interval = op1.Interval; }
+
+	SyncNodeType GetType() const override { return SyncNodeType::RepeatInfinite; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return _op1->GetValue(EnterRepetition(elapsedMillis));
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return _op1->GetValueQ16(EnterRepetition(elapsedMillis));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		const unsigned long elapsed = _period.Split(elapsedMillis, _op1->Interval);
+		const unsigned long change = ShiftChange(_op1->GetNextChange(elapsed), elapsedMillis - elapsed);
+		const unsigned long nextRepetition = elapsedMillis - elapsed + _op1->Interval;
+		return min(change, nextRepetition);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return false;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		size_t done = 0;
+		while (done < n)
+		{
+			const unsigned long local = EnterRepetition(startMillis + done * stepMillis);
+			size_t count = CountBefore(n - done, local, stepMillis, _op1->Interval);
+			if (count == 0) count = 1;
+			_op1->Render(out + done, count, local, stepMillis);
+			done += count;
+		}
+	}
+
+protected:
+	unsigned long _lastRepetion = 0;
+	SyncPeriod _period;
+
+	// Resets the operand when the repetition changes, returns the time within the repetition
+	unsigned long EnterRepetition(unsigned long elapsedMillis)
+	{
+		const unsigned long local = _period.Split(elapsedMillis, _op1->Interval);
+		if (_period.Index != _lastRepetion)
+		{
+			_lastRepetion = _period.Index;
+			_op1->Reset();
+		}
+		return local;
+	}
+};
+
+class SyncMirroring : public SyncTransformation
+{
+public:
+	SyncMirroring(SyncFunction& op1) : SyncTransformation(op1) { Interval = op1.Interval * 2; }
+
+	SyncNodeType GetType() const override { return SyncNodeType::Mirroring; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis < _op1->Interval)
+		{
+			return _op1->GetValue(elapsedMillis);
+		}
+		else
+		{
+			return _op1->GetValue(Interval - elapsedMillis);
+		}
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		const size_t rising = CountBefore(n, startMillis, stepMillis, _op1->Interval);
+		const size_t falling = CountBefore(n, startMillis, stepMillis, Interval + 1);
+		if (rising > 0) _op1->Render(out, rising, startMillis, stepMillis);
+		if (falling > rising)
+		{
+			_op1->Render(out + rising, falling - rising, Interval - (startMillis + (falling - 1) * stepMillis), stepMillis);
+			ReverseBlock(out + rising, falling - rising);
+		}
+		if (falling < n) SyncFunction::CalculateBlock(out + falling, n - falling, startMillis + falling * stepMillis, stepMillis);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return _op1->GetValueQ16(elapsedMillis < _op1->Interval ? elapsedMillis : Interval - elapsedMillis);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis < _op1->Interval)
+		{
+			const unsigned long change = _op1->GetNextChange(elapsedMillis);
+			return min(change, _op1->Interval);
+		}
+
+		// Past the Interval the mirrored time wraps after the Interval of the operand, where it may have settled
+		if (elapsedMillis > Interval && _op1->GetNextChange(_op1->Interval + 1UL) == SYNC_NEVER) return SYNC_NEVER;
+		return elapsedMillis + 1;
+	}
+};
+
+
+// Evaluates its operand once per frame and elapsed time, so a subgraph shared by several parents
+// is not recomputed for each of them. Operands with state (IsCacheable() false) are never cached
+class SyncMemo : public SyncTransformation
+{
+public:
+	SyncMemo(SyncFunction& op1) : SyncTransformation(op1), _cacheable(op1.IsCacheable()) {}
+
+	SyncNodeType GetType() const override { return SyncNodeType::Memo; }
+
+	void SetChild(uint8_t index, SyncFunction* child) override
+	{
+		_op1 = child;
+		_cacheable = child->IsCacheable();
+		Invalidate();
+	}
+
+	void Reset() override
+	{
+		_op1->Reset();
+		Invalidate();
+	}
+
+	void Invalidate()
+	{
+		_value.Valid = false;
+		_valueQ16.Valid = false;
+	}
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (!_cacheable) return _op1->GetValue(elapsedMillis);
+		if (!_value.Matches(elapsedMillis)) _value.Store(elapsedMillis, _op1->GetValue(elapsedMillis));
+		return _value.Value;
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		_op1->Render(out, n, startMillis, stepMillis);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (!_cacheable) return _op1->GetValueQ16(elapsedMillis);
+		if (!_valueQ16.Matches(elapsedMillis)) _valueQ16.Store(elapsedMillis, _op1->GetValueQ16(elapsedMillis));
+		return _valueQ16.Value;
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _op1->GetNextChange(elapsedMillis);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(elapsedMillis);
+	}
+
+protected:
+	template<typename T>
+	struct Entry
+	{
+		bool Valid = false;
+		uint32_t Frame;
+		unsigned long Elapsed;
+		T Value;
+
+		bool Matches(unsigned long elapsedMillis) const
+		{
+			return Valid && Frame == SyncClock::GetFrame() && Elapsed == elapsedMillis;
+		}
+
+		void Store(unsigned long elapsedMillis, T value)
+		{
+			Valid = true;
+			Frame = SyncClock::GetFrame();
+			Elapsed = elapsedMillis;
+			Value = value;
+		}
+	};
+
+	bool _cacheable;
+	Entry<float> _value;
+	Entry<int32_t> _valueQ16;
+};
+
+
+// Maps the output of its operand (0.0 - 1.0) through a gamma or easing curve (SyncCurve.h)
+class SyncTransformationCurve : public SyncTransformation
+{
+public:
+	SyncTransformationCurve(SyncFunction& op1, const SyncCurve& curve) : SyncTransformation(op1), Shape(curve) {}
+
+	SyncCurve Shape;
+
+	SyncNodeType GetType() const override { return SyncNodeType::Curve; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return Shape.Apply(_op1->GetValue(elapsedMillis));
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		_op1->Render(out, n, startMillis, stepMillis);
+		for (size_t i = 0; i < n; i++) out[i] = Shape.Apply(out[i]);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return Shape.ApplyQ16(_op1->GetValueQ16(elapsedMillis));
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _op1->GetNextChange(elapsedMillis);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(elapsedMillis);
+	}
+};
+
+// Start time of a graph built with SYNC_COMPACT_NODES, where the nodes have none, so it can be played and restarted
+// Without SYNC_COMPACT_NODES it only passes its operand through
+class SyncRoot : public SyncTransformation
+{
+public:
+	SyncRoot(SyncFunction& op1) : SyncTransformation(op1) {}
+
+#if SYNC_COMPACT_NODES
+	unsigned long StarTime = SyncClock::Now();
+
+	unsigned long GetStartTime() const override { return StarTime; }
+
+	void RestartAt(unsigned long nowMillis) override
+	{
+		StarTime = nowMillis;
+	}
+#endif
+
+	SyncNodeType GetType() const override { return SyncNodeType::Root; }
+
+	void Reset() override
+	{
+		_op1->Reset();
+	}
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		return _op1->GetValue(elapsedMillis);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		_op1->Render(out, n, startMillis, stepMillis);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		return _op1->GetValueQ16(elapsedMillis);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return _op1->GetNextChange(elapsedMillis);
+	}
+
+	bool IsFinished(unsigned long elapsedMillis) override
+	{
+		return _op1->IsFinished(elapsedMillis);
+	}
+};
+#endif
@@ -0,0 +1,104 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCTRIGGER_h
+#define _SYNCTRIGGER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+
+enum class SyncTriggerAction : uint8_t
+{
+	Trigger,	// Reset() and restart at the time of the event, e.g. to fire a one shot again
+	Restart,	// Restart at the time of the event, keeping the state of the nodes
+	Stop,		// Output 0.0 until the next Trigger or Restart
+};
+
+struct SyncTriggerEvent
+{
+	unsigned long Time;
+	uint8_t Channel;
+	SyncTriggerAction Action;
+};
+
+// Applies an event to a function, which starts at the time of the event instead of the time it is applied
+// The whole graph is reset and restarted, as the operands of operations run on their own StarTime
+inline void SyncApplyTrigger(SyncFunction& function, const SyncTriggerEvent& event)
+{
+	if (event.Action == SyncTriggerAction::Stop) return;
+
+	if (event.Action == SyncTriggerAction::Trigger) function.Reset();
+	function.RestartAt(event.Time);
+	for (uint8_t index = 0; index < function.GetChildCount(); index++)
+	{
+		SyncApplyTrigger(*function.GetChild(index), event);
+	}
+}
+
+// Events posted from an ISR (single producer) and taken by the main loop (single consumer), without locks
+// Each side only writes its own single byte index, which is atomic on single core boards
+// Size must be a power of two lower or equal to 128, one slot is always kept empty
+template<uint8_t Size>
+class SyncTriggerQueue
+{
+	static_assert(Size >= 2 && Size <= 128 && (Size & (Size - 1)) == 0, "Size must be a power of two up to 128");
+
+public:
+	// Producer side, returns false (and counts the event as dropped) if the queue is full
+	// The time must come from the SyncClock source, by default the time of the call
+	bool Post(uint8_t channel, SyncTriggerAction action = SyncTriggerAction::Trigger)
+	{
+		return Post(channel, action, SyncClock::Now());
+	}
+
+	bool Post(uint8_t channel, SyncTriggerAction action, unsigned long time)
+	{
+		const uint8_t head = _head;
+		const uint8_t next = (head + 1) & (Size - 1);
+		if (next == _tail)
+		{
+			_dropped++;
+			return false;
+		}
+
+		_events[head].Time = time;
+		_events[head].Channel = channel;
+		_events[head].Action = action;
+		_head = next;
+		return true;
+	}
+
+	// Consumer side, returns false if there are no events
+	bool Take(SyncTriggerEvent& event)
+	{
+		const uint8_t tail = _tail;
+		if (tail == _head) return false;
+
+		event.Time = _events[tail].Time;
+		event.Channel = _events[tail].Channel;
+		event.Action = _events[tail].Action;
+		_tail = (tail + 1) & (Size - 1);
+		return true;
+	}
+
+	bool IsEmpty() const { return _tail == _head; }
+
+	// Events lost because the queue was full, written by the producer
+	uint8_t GetDropped() const { return _dropped; }
+
+private:
+	volatile SyncTriggerEvent _events[Size];
+	volatile uint8_t _head = 0;
+	volatile uint8_t _tail = 0;
+	volatile uint8_t _dropped = 0;
+};
+#endif
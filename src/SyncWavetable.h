@@ -0,0 +1,191 @@
+/***************************************************
+Copyright (c) 2019 Luis Llamas
+(www.luisllamas.es)
+Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License
+ ****************************************************/
+
+#ifndef _SYNCWAVETABLE_h
+#define _SYNCWAVETABLE_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "Arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "SyncBases.h"
+#include "SyncMath.h"
+
+// Sample formats of SyncWavetable. Integer samples are stored relative to the range [Minimum, Maximum]
+// and their maximum is 1.0 in Q16 (65536), so the whole range is played back
+template<typename T> struct SyncSample;
+
+template<> struct SyncSample<float>
+{
+	static constexpr bool Scaled = false;
+	static constexpr float Max = 1.0;
+	static float Read(const float* sample, bool progmem) { return progmem ? pgm_read_float(sample) : *sample; }
+	static int32_t ToQ16(float sample) { return SyncToQ16(sample); }
+};
+
+template<> struct SyncSample<uint16_t>
+{
+	static constexpr bool Scaled = true;
+	static constexpr float Max = 65535.0;
+	static uint16_t Read(const uint16_t* sample, bool progmem) { return progmem ? pgm_read_word(sample) : *sample; }
+	static int32_t ToQ16(uint16_t sample) { return sample + (sample >> 15); }
+};
+
+template<> struct SyncSample<uint8_t>
+{
+	static constexpr bool Scaled = true;
+	static constexpr float Max = 255.0;
+	static uint8_t Read(const uint8_t* sample, bool progmem) { return progmem ? pgm_read_byte(sample) : *sample; }
+	static int32_t ToQ16(uint8_t sample) { return sample * 257L + (sample >> 7); }
+};
+
+// Plays back a table of evenly spaced samples, with linear interpolation
+// The table can be baked from any finite SyncFunction, or be a constant table (for example, in PROGMEM)
+// Evaluation cost does not depend on the size of the original graph. An empty table (size 0) outputs 0.0
+template<typename T>
+class SyncWavetable : public SyncFunction
+{
+public:
+	// Samples source at size evenly spaced times from 0 to source.Interval into buffer
+	SyncWavetable(SyncFunction& source, T* buffer, size_t size) : SyncFunction(source.Interval),
+		Minimum(0.0), Maximum(1.0), _table(buffer), _size(size), _progmem(false)
+	{
+		Bake(source, buffer);
+		Begin();
+	}
+
+	// Plays an existing table, whose samples span [minimum, maximum] (integer types) or are the values (float)
+	SyncWavetable(const T* table, size_t size, unsigned long t, float minimum = 0.0, float maximum = 1.0, bool progmem = false) : SyncFunction(t),
+		Minimum(minimum), Maximum(maximum), _table(table), _size(size), _progmem(progmem)
+	{
+		Begin();
+	}
+
+	float Minimum;
+	float Maximum;
+
+	SyncNodeType GetType() const override { return SyncNodeType::Wavetable; }
+
+	size_t GetSize() const { return _size; }
+
+	float Calculate(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval || _size == 0) return 0.0;
+		return Interpolate(static_cast<uint64_t>(elapsedMillis) * _step);
+	}
+
+	void CalculateBlock(float* out, size_t n, unsigned long startMillis, unsigned long stepMillis) override
+	{
+		uint64_t position = static_cast<uint64_t>(startMillis) * _step;
+		const uint64_t increment = static_cast<uint64_t>(stepMillis) * _step;
+		for (size_t i = 0; i < n; i++, startMillis += stepMillis, position += increment)
+			out[i] = startMillis > Interval || _size == 0 ? 0.0f : Interpolate(position);
+	}
+
+	int32_t CalculateQ16(unsigned long elapsedMillis) override
+	{
+		if (elapsedMillis > Interval || _size == 0) return 0;
+
+		const uint64_t position = static_cast<uint64_t>(elapsedMillis) * _step;
+		const size_t index = Index(position);
+		const int32_t fraction = static_cast<int32_t>((position >> 16) & 0xFFFF);
+		const int32_t sample0 = SampleQ16(index);
+		const int32_t sample1 = index + 1 < _size ? SampleQ16(index + 1) : sample0;
+		return sample0 + static_cast<int32_t>((static_cast<int64_t>(sample1 - sample0) * fraction) >> 16);
+	}
+
+	unsigned long CalculateNextChange(unsigned long elapsedMillis) override
+	{
+		return elapsedMillis > Interval ? SYNC_NEVER : elapsedMillis + 1;
+	}
+
+protected:
+	const T* _table;
+	size_t _size;
+	bool _progmem;
+
+	// Table position in 32.32 fixed point per tick
+	uint64_t _step;
+	float _scale;
+	int32_t _minimumQ16;
+	int32_t _rangeQ16;
+
+	void Begin()
+	{
+		_step = Interval == 0 || _size < 2 ? 0 : (static_cast<uint64_t>(_size - 1) << 32) / Interval;
+		_scale = SyncSample<T>::Scaled ? (Maximum - Minimum) / SyncSample<T>::Max : 1.0f;
+		_minimumQ16 = SyncToQ16(Minimum);
+		_rangeQ16 = SyncToQ16(Maximum - Minimum);
+	}
+
+	void Bake(SyncFunction& source, T* buffer)
+	{
+		if (_size == 0) return;
+		if (!SyncSample<T>::Scaled)
+		{
+			for (size_t i = 0; i < _size; i++) buffer[i] = source.GetValue(SampleTime(i));
+			return;
+		}
+
+		// Integer samples use the full range of the type, between the extremes of the source. The buffer only
+		// has room for the quantized samples, and the range must be known before quantizing, so the source is
+		// evaluated twice instead of keeping a float copy of the table. Sources with state (e.g. SyncDelta)
+		// may differ in the second pass, so the samples are clamped to the range
+		Minimum = Maximum = source.GetValue(0);
+		for (size_t i = 1; i < _size; i++)
+		{
+			const float value = source.GetValue(SampleTime(i));
+			if (value < Minimum) Minimum = value;
+			if (value > Maximum) Maximum = value;
+		}
+
+		const float range = Maximum - Minimum;
+		for (size_t i = 0; i < _size; i++)
+		{
+			float value = range > 0.0f ? (source.GetValue(SampleTime(i)) - Minimum) / range : 0.0f;
+			value = value > 1.0f ? 1.0f : value < 0.0f ? 0.0f : value;
+			buffer[i] = static_cast<T>(value * SyncSample<T>::Max + 0.5f);
+		}
+	}
+
+	unsigned long SampleTime(size_t index) const
+	{
+		if (_size < 2) return 0;
+		return static_cast<unsigned long>((static_cast<uint64_t>(Interval) * index + (_size - 1) / 2) / (_size - 1));
+	}
+
+	size_t Index(uint64_t position) const
+	{
+		const size_t index = static_cast<size_t>(position >> 32);
+		return index < _size ? index : _size - 1;
+	}
+
+	float Sample(size_t index) const
+	{
+		return Minimum * SyncSample<T>::Scaled + _scale * SyncSample<T>::Read(&_table[index], _progmem);
+	}
+
+	int32_t SampleQ16(size_t index) const
+	{
+		const int32_t sample = SyncSample<T>::ToQ16(SyncSample<T>::Read(&_table[index], _progmem));
+		if (!SyncSample<T>::Scaled) return sample;
+		return _minimumQ16 + SyncMulQ16(_rangeQ16, sample);
+	}
+
+	float Interpolate(uint64_t position) const
+	{
+		const size_t index = Index(position);
+		const float sample0 = Sample(index);
+		if (index + 1 >= _size) return sample0;
+
+		const float fraction = static_cast<uint32_t>(position) * (1.0f / 4294967296.0f);
+		return sample0 + (Sample(index + 1) - sample0) * fraction;
+	}
+};
+#endif